@@ -0,0 +1,171 @@
+// Data Structures, University of Malaga
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+
+#include "ArenaCircularLinkedList.h"
+#include "test/unit/UnitTest.h"
+
+#define INITIAL_CAPACITY 16
+
+// Returns the index of an unused slot, reusing freed slots first and growing
+// the storage when all of them are taken. Growing keeps indices valid
+static uint32_t ArenaCircularLinkedList_allocate(struct ArenaCircularLinkedList* p_list) {
+  if (p_list->first_free != ARENA_NIL) {
+    uint32_t slot = p_list->first_free;
+    p_list->first_free = p_list->p_nodes[slot].next;
+    return slot;
+  }
+
+  if (p_list->used == p_list->capacity) {
+    assert(p_list->capacity < ARENA_NIL / 2 && "Too many nodes");
+    uint32_t capacity = p_list->capacity == 0 ? INITIAL_CAPACITY : 2 * p_list->capacity;
+    struct ArenaNode* p_nodes = realloc(p_list->p_nodes, capacity * sizeof(struct ArenaNode));
+    assert(p_nodes != NULL && "Memory allocation failed");
+    p_list->p_nodes = p_nodes;
+    p_list->capacity = capacity;
+  }
+  return p_list->used++;
+}
+
+static void ArenaCircularLinkedList_release(struct ArenaCircularLinkedList* p_list, uint32_t slot) {
+  p_list->p_nodes[slot].next = p_list->first_free;
+  p_list->first_free = slot;
+}
+
+struct ArenaCircularLinkedList* ArenaCircularLinkedList_new() {
+  // Allocate memory for the list
+  struct ArenaCircularLinkedList* p_list = malloc(sizeof(struct ArenaCircularLinkedList));
+  assert(p_list != NULL && "Memory allocation failed");
+
+  // Initialize the list. Storage is allocated on first insertion
+  p_list->p_nodes = NULL;
+  p_list->capacity = 0;
+  p_list->used = 0;
+  p_list->first_free = ARENA_NIL;
+  p_list->last = ARENA_NIL;
+  p_list->size = 0;
+  return p_list;
+}
+
+void ArenaCircularLinkedList_insert(struct ArenaCircularLinkedList* p_list, int element) {
+  assert(p_list != NULL && "List is NULL");
+
+  // Take a slot for the new node. This may move the storage
+  uint32_t node = ArenaCircularLinkedList_allocate(p_list);
+  struct ArenaNode* p_nodes = p_list->p_nodes;
+  p_nodes[node].element = element;
+
+  if (p_list->size == 0) {
+    // The list is empty
+    p_nodes[node].next = node;
+    p_list->last = node;
+  } else {
+    uint32_t previous = p_list->last;         // Last node
+    uint32_t current = p_nodes[previous].next; // First node
+
+    // Find the correct position to insert the new element
+    size_t i = 0;
+    while (i < p_list->size && p_nodes[current].element < element) {
+      previous = current;
+      current = p_nodes[current].next;
+      i++;
+    }
+
+    // Insert the new element between previous and current
+    p_nodes[previous].next = node;
+    p_nodes[node].next = current;
+
+    // Update the last node if necessary
+    if (element > p_nodes[p_list->last].element) {
+      p_list->last = node;
+    }
+  }
+  // Update the size of the list
+  p_list->size++;
+}
+
+void ArenaCircularLinkedList_remove(struct ArenaCircularLinkedList* p_list, size_t index) {
+  assert(p_list != NULL && "List is NULL");
+  assert(index < p_list->size && "Index out of bounds");
+
+  struct ArenaNode* p_nodes = p_list->p_nodes;
+  uint32_t previous = p_list->last;           // Last node
+  uint32_t toDelete = p_nodes[previous].next; // First node
+
+  // Find the node to delete
+  for (size_t i = 0; i < index; i++) {
+    previous = toDelete;
+    toDelete = p_nodes[toDelete].next;
+  }
+
+  // Remove the node from the list
+  p_nodes[previous].next = p_nodes[toDelete].next;
+
+  // Update the last node if necessary
+  if (toDelete == p_list->last) {
+    p_list->last = p_list->size == 1 ? ARENA_NIL : previous;
+  }
+
+  // Give the slot back for reuse
+  ArenaCircularLinkedList_release(p_list, toDelete);
+
+  // Update the size of the list
+  p_list->size--;
+}
+
+void ArenaCircularLinkedList_print(const struct ArenaCircularLinkedList* p_list) {
+  assert(p_list != NULL && "List is NULL");
+
+  if (p_list->size != 0) {
+    uint32_t current = p_list->p_nodes[p_list->last].next;
+    for (size_t i = 0; i < p_list->size; i++) {
+      printf("%d ", p_list->p_nodes[current].element);
+      current = p_list->p_nodes[current].next;
+    }
+  }
+  printf("\n");
+}
+
+void ArenaCircularLinkedList_free(struct ArenaCircularLinkedList** p_p_list) {
+  assert(p_p_list != NULL && "Pointer is NULL");
+
+  struct ArenaCircularLinkedList* p_list = *p_p_list;
+  assert(p_list != NULL && "List is NULL");
+
+  // All the nodes are released at once with their storage
+  free(p_list->p_nodes);
+  free(p_list);
+
+  // Set the pointer to the list to NULL
+  *p_p_list = NULL;
+}
+
+bool ArenaCircularLinkedList_equals(const struct ArenaCircularLinkedList* p_list1, const struct ArenaCircularLinkedList* p_list2) {
+  assert(p_list1 != NULL && "List 1 is NULL");
+  assert(p_list2 != NULL && "List 2 is NULL");
+
+  if (p_list1->size != p_list2->size) {
+    return false;
+  }
+
+  if (p_list1->size == 0) {
+    return true;
+  }
+
+  const struct ArenaNode* p_nodes1 = p_list1->p_nodes;
+  const struct ArenaNode* p_nodes2 = p_list2->p_nodes;
+  uint32_t current1 = p_nodes1[p_list1->last].next;
+  uint32_t current2 = p_nodes2[p_list2->last].next;
+
+  for (size_t i = 0; i < p_list1->size; i++) {
+    if (p_nodes1[current1].element != p_nodes2[current2].element) {
+      return false;
+    }
+    current1 = p_nodes1[current1].next;
+    current2 = p_nodes2[current2].next;
+  }
+
+  return true;
+}
@@ -0,0 +1,38 @@
+// Data Structures, University of Malaga
+//
+// Sorted circular linked list whose nodes live in a single growable array and
+// are linked by 32-bit indices instead of pointers. A node takes 8 bytes
+// instead of 16, so twice as many fit in a cache line. Slots of removed nodes
+// are chained into a free list and reused by later insertions.
+
+#ifndef ARENA_CIRCULAR_LINKED_LIST_H
+#define ARENA_CIRCULAR_LINKED_LIST_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define ARENA_NIL UINT32_MAX // index that designates no node
+
+struct ArenaNode {
+  int element;   // element in the node
+  uint32_t next; // index of the next node (of the next free slot for free slots)
+};
+
+struct ArenaCircularLinkedList {
+  struct ArenaNode* p_nodes; // storage for the nodes
+  uint32_t capacity;         // number of slots in p_nodes
+  uint32_t used;             // slots at or above this index have never been used
+  uint32_t first_free;       // first free slot below used, or ARENA_NIL
+  uint32_t last;             // index of the last node, or ARENA_NIL if the list is empty
+  size_t size;               // number of elements in the list
+};
+
+struct ArenaCircularLinkedList* ArenaCircularLinkedList_new();
+void ArenaCircularLinkedList_insert(struct ArenaCircularLinkedList* p_list, int element);
+void ArenaCircularLinkedList_remove(struct ArenaCircularLinkedList* p_list, size_t index);
+void ArenaCircularLinkedList_print(const struct ArenaCircularLinkedList* p_list);
+void ArenaCircularLinkedList_free(struct ArenaCircularLinkedList** p_p_list);
+bool ArenaCircularLinkedList_equals(const struct ArenaCircularLinkedList* p_list1, const struct ArenaCircularLinkedList* p_list2);
+
+#endif
@@ -5,20 +5,333 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
 #include <assert.h>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include "CircularLinkedList.h"
 #include "test/unit/UnitTest.h"
 
+// Hash of a single element (splitmix64 finalizer). Fingerprints add them up
+static inline uint64_t CircularLinkedList_hashElement(int element) {
+  uint64_t x = (uint32_t) element + 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+#ifdef CIRCULAR_LINKED_LIST_FINGERPRINT
+#define FINGERPRINT_ADD(p_list, element) ((p_list)->fingerprint += CircularLinkedList_hashElement(element))
+#define FINGERPRINT_SUBTRACT(p_list, element) ((p_list)->fingerprint -= CircularLinkedList_hashElement(element))
+#define FINGERPRINT_MOVE(p_to, p_from) ((p_to)->fingerprint += (p_from)->fingerprint, (p_from)->fingerprint = 0)
+#else
+#define FINGERPRINT_ADD(p_list, element) ((void) 0)
+#define FINGERPRINT_SUBTRACT(p_list, element) ((void) 0)
+#define FINGERPRINT_MOVE(p_to, p_from) ((void) 0)
+#endif
+
+#ifdef CIRCULAR_LINKED_LIST_STATS
+static struct CircularLinkedList_Stats stats;
+
+static void CircularLinkedList_record(struct CircularLinkedList_OperationStats* p_stats, uint64_t visited) {
+  p_stats->calls++;
+  p_stats->visited += visited;
+  if (visited > p_stats->max) {
+    p_stats->max = visited;
+  }
+  size_t bucket = 0;
+  for (uint64_t v = visited; v != 0 && bucket < CIRCULAR_LINKED_LIST_STATS_BUCKETS - 1; v >>= 1) {
+    bucket++;
+  }
+  p_stats->histogram[bucket]++;
+}
+
+#define STATS_RECORD(operation, visited) CircularLinkedList_record(&stats.operation, (visited))
+#else
+#define STATS_RECORD(operation, visited) ((void) 0)
+#endif
+
+#if defined(CIRCULAR_LINKED_LIST_SELF_CHECK) && !defined(NDEBUG)
+// Checks the structure of a list in O(n) time and O(1) space: the nodes
+// after p_last form a cycle through p_last (found with Brent's algorithm,
+// which also stops on cycles that do not go through it), the elements are
+// sorted and there are size of them
+static void CircularLinkedList_check(const struct CircularLinkedList* p_list) {
+  assert((p_list->size == 0) == (p_list->p_last == NULL) && "Size does not match p_last");
+  assert((p_list->inline_used == 0 || p_list->size <= CIRCULAR_LINKED_LIST_INLINE_LIMIT) && "Inline nodes in a large list");
+  if (p_list->size == 0) {
+    return;
+  }
+
+  const struct Node* p_first = p_list->p_last->p_next;
+  const struct Node* p_previous = p_first;
+  const struct Node* p_tortoise = p_first;
+  const struct Node* p_current = p_first->p_next;
+  size_t count = 1;
+  size_t steps = 1;
+  size_t power = 1;
+  while (p_current != p_first) {
+    assert(p_current != NULL && "NULL node in list");
+    assert(p_current != p_tortoise && "Cycle that does not go through the first node");
+    assert(p_previous->element <= p_current->element && "Elements are not sorted");
+    if (steps == power) {
+      p_tortoise = p_current;
+      power *= 2;
+      steps = 0;
+    }
+    p_previous = p_current;
+    p_current = p_current->p_next;
+    count++;
+    steps++;
+  }
+  assert(count == p_list->size && "Size does not match the number of nodes");
+  assert(p_previous == p_list->p_last && "p_last is not the last node");
+}
+
+#define SELF_CHECK(p_list) CircularLinkedList_check(p_list)
+#else
+#define SELF_CHECK(p_list) ((void) 0)
+#endif
+
+#ifdef CIRCULAR_LINKED_LIST_TRACE
+static FILE* p_trace = NULL;
+
+#define TRACE(...) (p_trace != NULL ? (void) fprintf(p_trace, __VA_ARGS__) : (void) 0)
+#define TRACE_NAME(p_list) ((unsigned long long) (uintptr_t) (p_list))
+#else
+#define TRACE(...) ((void) 0)
+#endif
+
+// Blocks of nodes created by compaction. Each node records its position in
+// its block, so the block is found from the node alone and freed when its
+// last node is released, wherever that node has been moved to. Moved nodes
+// may leave a block shared by lists used from different threads, so the
+// count of live nodes is atomic. Nodes allocated alone never touch it
+struct NodeBlock {
+  atomic_size_t live;  // nodes of the block still in use
+  struct Node nodes[]; // the nodes
+};
+
+_Static_assert(sizeof(struct CircularLinkedList) == 2 * CIRCULAR_LINKED_LIST_ALIGNMENT, "A list must fill two cache lines");
+
+// The block field must not make nodes larger where it fits in their padding
+_Static_assert(UINTPTR_MAX <= UINT32_MAX || sizeof(struct Node) == 2 * sizeof(struct Node*), "Node has grown");
+
+// Positions saturate at UINT32_MAX. A node with a saturated position is
+// NODE_BLOCK_JUMP nodes after another node, closer to the start of the block
+#define NODE_BLOCK_JUMP (UINT32_MAX - 1)
+
+// Allocates a block of count nodes, all of them in use
+static struct Node* CircularLinkedList_allocateBlock(size_t count) {
+  struct NodeBlock* p_block = malloc(sizeof(struct NodeBlock) + count * sizeof(struct Node));
+  assert(p_block != NULL && "Memory allocation failed");
+  atomic_init(&p_block->live, count);
+  for (size_t i = 0; i < count; i++) {
+    p_block->nodes[i].block = i < NODE_BLOCK_JUMP ? (uint32_t) (i + 1) : UINT32_MAX;
+  }
+  return p_block->nodes;
+}
+
+// Block holding p_node, whose block field is not 0
+static struct NodeBlock* CircularLinkedList_blockOf(struct Node* p_node) {
+  while (p_node->block == UINT32_MAX) {
+    p_node -= NODE_BLOCK_JUMP;
+  }
+  struct Node* p_first = p_node - (p_node->block - 1);
+  return (struct NodeBlock*) ((char*) p_first - offsetof(struct NodeBlock, nodes));
+}
+
+static inline bool CircularLinkedList_isInline(const struct CircularLinkedList* p_list, const struct Node* p_node) {
+  return p_node >= p_list->inline_nodes && p_node < p_list->inline_nodes + CIRCULAR_LINKED_LIST_INLINE_NODES;
+}
+
+// Returns a heap node for p_list: a node kept by clear or reserve in p_list,
+// or else in p_other unless it is NULL, else a new one
+static struct Node* CircularLinkedList_allocateHeapNode(struct CircularLinkedList* p_list, struct CircularLinkedList* p_other) {
+  struct CircularLinkedList* p_owner = p_list->p_free == NULL && p_other != NULL ? p_other : p_list;
+  if (p_owner->p_free != NULL) {
+    struct Node* p_node = p_owner->p_free;
+    p_owner->p_free = p_node->p_next;
+    p_owner->free_count--;
+    return p_node;
+  }
+
+  struct Node* p_node = malloc(sizeof(struct Node));
+  assert(p_node != NULL && "Memory allocation failed");
+  p_node->block = 0;
+  return p_node;
+}
+
+// Returns a free inline node of p_list, or NULL if all of them are in use
+static struct Node* CircularLinkedList_takeInline(struct CircularLinkedList* p_list) {
+  for (unsigned i = 0; i < CIRCULAR_LINKED_LIST_INLINE_NODES; i++) {
+    if ((p_list->inline_used & (1u << i)) == 0) {
+      p_list->inline_used |= 1u << i;
+      return &p_list->inline_nodes[i];
+    }
+  }
+  return NULL;
+}
+
+// Returns a node for p_list: a free inline node if the list is small enough
+// to keep inline nodes, else a heap node
+static struct Node* CircularLinkedList_allocateNode(struct CircularLinkedList* p_list) {
+  struct Node* p_node = NULL;
+  if (p_list->size < CIRCULAR_LINKED_LIST_INLINE_LIMIT) {
+    p_node = CircularLinkedList_takeInline(p_list);
+  }
+  return p_node != NULL ? p_node : CircularLinkedList_allocateHeapNode(p_list, NULL);
+}
+
+// Releases a node of p_list, whether it is inline, on its own or in a block
+static void CircularLinkedList_releaseNode(struct CircularLinkedList* p_list, struct Node* p_node) {
+  if (CircularLinkedList_isInline(p_list, p_node)) {
+    p_list->inline_used &= ~(1u << (p_node - p_list->inline_nodes));
+    return;
+  }
+  if (p_node->block == 0) {
+    free(p_node);
+    return;
+  }
+
+  // Only the release of the last node has to see the writes made through the
+  // other ones, so that the block is not freed under them
+  struct NodeBlock* p_block = CircularLinkedList_blockOf(p_node);
+  if (atomic_fetch_sub_explicit(&p_block->live, 1, memory_order_release) == 1) {
+    atomic_thread_fence(memory_order_acquire);
+    free(p_block);
+  }
+}
+
+// Moves the inline nodes among the count nodes that follow p_previous out of
+// p_list, so that they can be linked into p_destination, or p_list itself
+// when it outgrows them. Their elements are copied into free inline nodes of
+// a destination that stays small enough to keep them, else into nodes kept
+// by either list, and only else into new nodes. Lists with inline nodes have
+// at most CIRCULAR_LINKED_LIST_INLINE_LIMIT nodes, so this takes O(1)
+static void CircularLinkedList_evictInline(struct CircularLinkedList* p_list, struct Node* p_previous, size_t count, struct CircularLinkedList* p_destination) {
+  assert((p_list->inline_used == 0 || p_list->size <= CIRCULAR_LINKED_LIST_INLINE_LIMIT) && "Inline nodes in a large list");
+  bool to_inline = p_destination != p_list && p_destination->size + count <= CIRCULAR_LINKED_LIST_INLINE_LIMIT;
+  for (size_t i = 0; i < count && p_list->inline_used != 0; i++) {
+    struct Node* p_current = p_previous->p_next;
+    if (CircularLinkedList_isInline(p_list, p_current)) {
+      struct Node* p_node = to_inline ? CircularLinkedList_takeInline(p_destination) : NULL;
+      if (p_node == NULL) {
+        p_node = CircularLinkedList_allocateHeapNode(p_list, p_destination);
+      }
+      p_node->element = p_current->element;
+      p_node->p_next = p_current->p_next;
+      if (p_current == p_previous) {
+        p_node->p_next = p_node; // the only node in the list
+      } else {
+        p_previous->p_next = p_node;
+      }
+      if (p_current == p_list->p_last) {
+        p_list->p_last = p_node;
+      }
+      CircularLinkedList_releaseNode(p_list, p_current);
+      p_current = p_node;
+    }
+    p_previous = p_current;
+  }
+}
+
+// Moves all the inline nodes of p_list to the heap if adding count nodes
+// makes it too large to keep them. Returns whether any node was moved
+static bool CircularLinkedList_outgrowInline(struct CircularLinkedList* p_list, size_t count) {
+  if (p_list->inline_used == 0 || p_list->size + count <= CIRCULAR_LINKED_LIST_INLINE_LIMIT) {
+    return false;
+  }
+  CircularLinkedList_evictInline(p_list, p_list->p_last, p_list->size, p_list);
+  return true;
+}
+
+// Returns count (> 0) consecutive nodes for the empty list p_list, for the
+// caller to set and link in the same pass before adopting them. Small lists
+// use the inline nodes. Otherwise all the nodes come from a single block,
+// which is freed with the last of them
+static struct Node* CircularLinkedList_allocateNodes(struct CircularLinkedList* p_list, size_t count) {
+  if (count <= CIRCULAR_LINKED_LIST_INLINE_NODES) {
+    p_list->inline_used = (1u << count) - 1;
+    return p_list->inline_nodes;
+  }
+  return CircularLinkedList_allocateBlock(count);
+}
+
+// Frees the nodes returned by allocateNodes when they are not to be adopted
+static void CircularLinkedList_discardNodes(struct CircularLinkedList* p_list, struct Node* p_nodes) {
+  if (!CircularLinkedList_isInline(p_list, p_nodes)) {
+    free(CircularLinkedList_blockOf(p_nodes));
+  }
+  p_list->inline_used = 0;
+}
+
+// Makes p_list hold the count nodes returned by allocateNodes, each of them
+// linked to the next one but the last, which closes the cycle
+static void CircularLinkedList_adoptNodes(struct CircularLinkedList* p_list, struct Node* p_nodes, size_t count) {
+  p_nodes[count - 1].p_next = p_nodes;
+  p_list->p_last = &p_nodes[count - 1];
+  p_list->size = count;
+}
+
+// Called by insert and remove before they search the list. Compacts it once
+// searches have visited ratio times as many nodes as compaction would copy
+// plus those linked since the last compaction, so that compaction takes at
+// most 1 / ratio of the time spent searching. Read-only operations never
+// compact, so they keep cursors valid and can run concurrently. Returns
+// whether the list was compacted
+static bool CircularLinkedList_compactIfDue(struct CircularLinkedList* p_list) {
+  if (p_list->compact_ratio != 0 && p_list->linked != 0
+      && p_list->traversed >= p_list->compact_ratio * (p_list->size + p_list->linked)) {
+    CircularLinkedList_compact(p_list);
+    return true;
+  }
+  return false;
+}
+
+// Called by insert_at_hint and remove_at_cursor once they are done with the
+// list. Compaction keeps the nodes in order in a single block, so the cursor
+// is moved to the node now at its index
+static void CircularLinkedList_compactIfDueAt(struct CircularLinkedList* p_list, struct CircularLinkedList_Cursor* p_cursor) {
+  if (CircularLinkedList_compactIfDue(p_list) && p_list->size != 0) {
+    struct Node* p_first = p_list->p_last->p_next;
+    p_cursor->p_previous = p_cursor->index == 0 ? p_list->p_last : &p_first[p_cursor->index - 1];
+  }
+}
+
 //// BEGIN (A)
 struct CircularLinkedList* CircularLinkedList_new() {
-  // Allocate memory for the list
+  // Allocate memory for the list, aligned so that it spans two cache lines
+  // rather than three. MSVC lacks aligned_alloc and its aligned allocations
+  // need their own free
+#if defined(_MSC_VER)
   struct CircularLinkedList* p_list = malloc(sizeof(struct CircularLinkedList));
+#else
+  struct CircularLinkedList* p_list = aligned_alloc(CIRCULAR_LINKED_LIST_ALIGNMENT, sizeof(struct CircularLinkedList));
+#endif
   assert(p_list != NULL && "Memory allocation failed");
 
   // Initialize the list
   p_list->p_last = NULL;
   p_list->size = 0;
+  p_list->traversed = 0;
+  p_list->linked = 0;
+  p_list->compact_ratio = 0;
+  p_list->p_free = NULL;
+  p_list->free_count = 0;
+  p_list->inline_used = 0;
+#ifdef CIRCULAR_LINKED_LIST_FINGERPRINT
+  p_list->fingerprint = 0;
+#endif
+  TRACE("n %llu\n", TRACE_NAME(p_list));
   return p_list;
 }
 //// END (A)
@@ -27,16 +340,19 @@ struct CircularLinkedList* CircularLinkedList_new() {
 //// BEGIN (B)
 void CircularLinkedList_insert(struct CircularLinkedList* p_list, int element) {
   assert(p_list != NULL && "List is NULL");
+  TRACE("i %llu %d\n", TRACE_NAME(p_list), element);
+  CircularLinkedList_compactIfDue(p_list);
+  CircularLinkedList_outgrowInline(p_list, 1);
 
-  // Allocate memory for the new node and initialize element
-  struct Node* p_node = malloc(sizeof(struct Node));
-  assert(p_node != NULL && "Memory allocation failed");
+  // Get a node for the new element, inline if possible
+  struct Node* p_node = CircularLinkedList_allocateNode(p_list);
   p_node->element = element;
 
   if (p_list->size == 0) {
     // The list is empty
     p_list->p_last = p_node;
     p_node->p_next = p_node;
+    STATS_RECORD(insert, 0);
   } else {
     // The list is not empty
     struct Node* p_previous = p_list->p_last;    // Last node
@@ -49,6 +365,8 @@ void CircularLinkedList_insert(struct CircularLinkedList* p_list, int element) {
       p_current = p_current->p_next;
       i++;
     }
+    STATS_RECORD(insert, i);
+    p_list->traversed += i;
 
     // Insert the new element between p_previous and p_current
     p_previous->p_next = p_node;
@@ -61,6 +379,9 @@ void CircularLinkedList_insert(struct CircularLinkedList* p_list, int element) {
   }
   // Update the size of the list
   p_list->size++;  
+  p_list->linked++;
+  FINGERPRINT_ADD(p_list, element);
+  SELF_CHECK(p_list);
 }
 //// END (B)
 
@@ -69,6 +390,8 @@ void CircularLinkedList_insert(struct CircularLinkedList* p_list, int element) {
 void CircularLinkedList_remove(struct CircularLinkedList* p_list, size_t index) {
   assert(p_list != NULL && "List is NULL"); 
   assert(index < p_list->size && "Index out of bounds");
+  TRACE("r %llu %zu\n", TRACE_NAME(p_list), index);
+  CircularLinkedList_compactIfDue(p_list);
 
   struct Node* p_previous = p_list->p_last;     // Last node
   struct Node* p_toDelete = p_previous->p_next; // First node
@@ -78,6 +401,8 @@ void CircularLinkedList_remove(struct CircularLinkedList* p_list, size_t index)
     p_previous = p_toDelete;
     p_toDelete = p_toDelete->p_next;
   }
+  STATS_RECORD(remove, index);
+  p_list->traversed += index;
 
   // Remove the node from the list 
   p_previous->p_next = p_toDelete->p_next;
@@ -88,10 +413,12 @@ void CircularLinkedList_remove(struct CircularLinkedList* p_list, size_t index)
   }
 
   // Free the memory allocated for the node
-  free(p_toDelete);
+  FINGERPRINT_SUBTRACT(p_list, p_toDelete->element);
+  CircularLinkedList_releaseNode(p_list, p_toDelete);
 
   // Update the size of the list
   p_list->size--;
+  SELF_CHECK(p_list);
 }
 //// END (C)
 
@@ -99,17 +426,9 @@ void CircularLinkedList_remove(struct CircularLinkedList* p_list, size_t index)
 //// BEGIN (D)
 void CircularLinkedList_print(const struct CircularLinkedList* p_list) {
   assert(p_list != NULL && "List is NULL");
+  TRACE("p %llu\n", TRACE_NAME(p_list));
 
-  if (p_list->size != 0) {
-    struct Node* p_first = p_list->p_last->p_next;
-    struct Node* p_current = p_first;
-    
-    for (size_t i = 0; i < p_list->size; i++) {
-        printf("%d ", p_current->element);
-        p_current = p_current->p_next;
-    }
-  }
-  printf("\n");
+  CircularLinkedList_write(p_list, stdout);
 }
 //// END (D)
 
@@ -120,13 +439,21 @@ void CircularLinkedList_free(struct CircularLinkedList** p_p_list) {
 
   struct CircularLinkedList* p_list = *p_p_list;
   assert(p_list != NULL && "List is NULL"); 
+  TRACE("f %llu\n", TRACE_NAME(p_list));
 
   // Free all the nodes in the list 
   struct Node* p_current = p_list->p_last;
   for (size_t i = 0; i < p_list->size; i++) {
     struct Node* p_toDelete = p_current;
     p_current = p_current->p_next;
-    free(p_toDelete);
+    CircularLinkedList_releaseNode(p_list, p_toDelete);
+  }
+
+  // Free the nodes kept for reuse
+  while (p_list->p_free != NULL) {
+    struct Node* p_toDelete = p_list->p_free;
+    p_list->p_free = p_toDelete->p_next;
+    CircularLinkedList_releaseNode(p_list, p_toDelete);
   }
 
   // Free the list structure 
@@ -142,26 +469,1156 @@ void CircularLinkedList_free(struct CircularLinkedList** p_p_list) {
 bool CircularLinkedList_equals(const struct CircularLinkedList* p_list1, const struct CircularLinkedList* p_list2) {
   assert(p_list1 != NULL && "List 1 is NULL");
   assert(p_list2 != NULL && "List 2 is NULL"); 
+  TRACE("e %llu %llu\n", TRACE_NAME(p_list1), TRACE_NAME(p_list2));
   
   if (p_list1->size != p_list2->size) {
+    STATS_RECORD(equals, 0);
     return false;
   }
 
+#ifdef CIRCULAR_LINKED_LIST_FINGERPRINT
+  // Different fingerprints mean different elements
+  if (p_list1->fingerprint != p_list2->fingerprint) {
+    STATS_RECORD(equals, 0);
+    return false;
+  }
+#endif
+
   if (p_list1->size == 0) {
+    STATS_RECORD(equals, 0);
     return true;
   }
 
   const struct Node* p_current1 = p_list1->p_last->p_next;
   const struct Node* p_current2 = p_list2->p_last->p_next;
 
+  // Each list counts as one visited node per compared position
   for (size_t i = 0; i < p_list1->size; i++) {
     if (p_current1->element != p_current2->element) {
+      STATS_RECORD(equals, 2 * (i + 1));
       return false;
     }
     p_current1 = p_current1->p_next;
     p_current2 = p_current2->p_next;
   }
 
+  STATS_RECORD(equals, 2 * p_list1->size);
   return true;
 }
 //// END (F)
+
+
+//// BEGIN (G)
+struct CircularLinkedList_Cursor CircularLinkedList_cursor_begin(const struct CircularLinkedList* p_list) {
+  assert(p_list != NULL && "List is NULL");
+
+  struct CircularLinkedList_Cursor cursor = { p_list->p_last, 0 };
+  return cursor;
+}
+
+void CircularLinkedList_cursor_next(const struct CircularLinkedList* p_list, struct CircularLinkedList_Cursor* p_cursor) {
+  assert(p_list != NULL && "List is NULL");
+  assert(p_cursor != NULL && "Cursor is NULL");
+  assert(p_cursor->index < p_list->size && "Cursor out of bounds");
+  (void) p_list;
+
+  // Moving past the last node leaves the cursor at index size
+  p_cursor->p_previous = p_cursor->p_previous->p_next;
+  p_cursor->index++;
+}
+
+int CircularLinkedList_cursor_element(const struct CircularLinkedList* p_list, const struct CircularLinkedList_Cursor* p_cursor) {
+  assert(p_list != NULL && "List is NULL");
+  assert(p_cursor != NULL && "Cursor is NULL");
+  assert(p_cursor->index < p_list->size && "Cursor out of bounds");
+  (void) p_list;
+
+  return p_cursor->p_previous->p_next->element;
+}
+
+void CircularLinkedList_insert_at_hint(struct CircularLinkedList* p_list, struct CircularLinkedList_Cursor* p_cursor, int element) {
+  assert(p_list != NULL && "List is NULL");
+  assert(p_cursor != NULL && "Cursor is NULL");
+
+  // Get a node for the new element, inline if possible. Moving inline nodes
+  // to the heap may move the node the cursor hints at
+  if (CircularLinkedList_outgrowInline(p_list, 1)) {
+    p_cursor->p_previous = NULL;
+  }
+  struct Node* p_node = CircularLinkedList_allocateNode(p_list);
+  p_node->element = element;
+
+  if (p_list->size == 0) {
+    // The list is empty
+    p_list->p_last = p_node;
+    p_node->p_next = p_node;
+    p_cursor->p_previous = p_node;
+    p_cursor->index = 0;
+  } else if (element >= p_list->p_last->element) {
+    // Tail fast path: the new node goes right after the last one
+    p_node->p_next = p_list->p_last->p_next;
+    p_list->p_last->p_next = p_node;
+    p_cursor->p_previous = p_list->p_last;
+    p_cursor->index = p_list->size;
+    p_list->p_last = p_node;
+  } else {
+    struct Node* p_previous = p_list->p_last; // Last node
+    size_t i = 0;
+
+    // Resume the search from the cursor if element does not go before it
+    if (p_cursor->p_previous != NULL && p_cursor->index < p_list->size && p_cursor->p_previous->p_next->element <= element) {
+      p_previous = p_cursor->p_previous;
+      i = p_cursor->index;
+    }
+    size_t start = i;
+
+    // Find the correct position. The last node stops the search, as element is smaller
+    struct Node* p_current = p_previous->p_next;
+    while (p_current->element < element) {
+      p_previous = p_current;
+      p_current = p_current->p_next;
+      i++;
+    }
+
+    // Insert the new element between p_previous and p_current
+    p_previous->p_next = p_node;
+    p_node->p_next = p_current;
+    p_cursor->p_previous = p_previous;
+    p_cursor->index = i;
+    p_list->traversed += i - start;
+  }
+  // Update the size of the list
+  p_list->size++;
+  p_list->linked++;
+  FINGERPRINT_ADD(p_list, element);
+  CircularLinkedList_compactIfDueAt(p_list, p_cursor);
+  SELF_CHECK(p_list);
+}
+
+void CircularLinkedList_remove_at_cursor(struct CircularLinkedList* p_list, struct CircularLinkedList_Cursor* p_cursor) {
+  assert(p_list != NULL && "List is NULL");
+  assert(p_cursor != NULL && "Cursor is NULL");
+  assert(p_cursor->index < p_list->size && "Cursor out of bounds");
+
+  struct Node* p_previous = p_cursor->p_previous;
+  struct Node* p_toDelete = p_previous->p_next;
+
+  // Remove the node from the list
+  p_previous->p_next = p_toDelete->p_next;
+
+  // Update the last node if necessary. The cursor then wraps around to the first node
+  if (p_toDelete == p_list->p_last) {
+    p_list->p_last = p_list->size == 1 ? NULL : p_previous;
+    p_cursor->p_previous = p_list->p_last;
+    p_cursor->index = 0;
+  }
+
+  // Free the memory allocated for the node
+  FINGERPRINT_SUBTRACT(p_list, p_toDelete->element);
+  CircularLinkedList_releaseNode(p_list, p_toDelete);
+
+  // Update the size of the list
+  p_list->size--;
+  CircularLinkedList_compactIfDueAt(p_list, p_cursor);
+  SELF_CHECK(p_list);
+}
+//// END (G)
+
+
+//// BEGIN (H)
+long long CircularLinkedList_sum(const struct CircularLinkedList* p_list) {
+  assert(p_list != NULL && "List is NULL");
+
+  long long sum = 0;
+  int element;
+  CircularLinkedList_for_each(element, p_list) {
+    sum += element;
+  }
+  return sum;
+}
+
+size_t CircularLinkedList_count_if(const struct CircularLinkedList* p_list, bool (*p_predicate)(int element, void* p_context), void* p_context) {
+  assert(p_list != NULL && "List is NULL");
+  assert(p_predicate != NULL && "Predicate is NULL");
+
+  size_t count = 0;
+  int element;
+  CircularLinkedList_for_each(element, p_list) {
+    count += p_predicate(element, p_context);
+  }
+  return count;
+}
+
+int CircularLinkedList_min(const struct CircularLinkedList* p_list) {
+  assert(p_list != NULL && "List is NULL");
+  assert(p_list->size != 0 && "List is empty");
+
+  // The list is sorted: the minimum is in the first node
+  return p_list->p_last->p_next->element;
+}
+
+int CircularLinkedList_max(const struct CircularLinkedList* p_list) {
+  assert(p_list != NULL && "List is NULL");
+  assert(p_list->size != 0 && "List is empty");
+
+  // The list is sorted: the maximum is in the last node
+  return p_list->p_last->element;
+}
+//// END (H)
+
+
+//// BEGIN (I)
+struct CircularLinkedList_Cursor CircularLinkedList_lower_bound(const struct CircularLinkedList* p_list, int element) {
+  assert(p_list != NULL && "List is NULL");
+
+  // Cursor at the first element that is not smaller than element, or past the
+  // last node (index size) if there is none
+  struct CircularLinkedList_Cursor cursor = { p_list->p_last, 0 };
+  if (p_list->size == 0 || element <= p_list->p_last->p_next->element) {
+    return cursor;
+  }
+  if (element > p_list->p_last->element) {
+    cursor.index = p_list->size;
+    return cursor;
+  }
+
+  // The element is within range: the last node stops the search
+  while (cursor.p_previous->p_next->element < element) {
+    cursor.p_previous = cursor.p_previous->p_next;
+    cursor.index++;
+  }
+  return cursor;
+}
+
+bool CircularLinkedList_contains(const struct CircularLinkedList* p_list, int element) {
+  assert(p_list != NULL && "List is NULL");
+
+  // Reject elements outside the range of the list without walking it
+  if (p_list->size == 0 || element < p_list->p_last->p_next->element || element > p_list->p_last->element) {
+    return false;
+  }
+
+  struct CircularLinkedList_Cursor cursor = CircularLinkedList_lower_bound(p_list, element);
+  return cursor.p_previous->p_next->element == element;
+}
+
+size_t CircularLinkedList_count(const struct CircularLinkedList* p_list, int element) {
+  assert(p_list != NULL && "List is NULL");
+
+  // Reject elements outside the range of the list without walking it
+  if (p_list->size == 0 || element < p_list->p_last->p_next->element || element > p_list->p_last->element) {
+    return 0;
+  }
+
+  // Equal elements are adjacent: count them from the first one on
+  struct CircularLinkedList_Cursor cursor = CircularLinkedList_lower_bound(p_list, element);
+  const struct Node* p_current = cursor.p_previous->p_next;
+  size_t count = 0;
+  while (cursor.index + count < p_list->size && p_current->element == element) {
+    p_current = p_current->p_next;
+    count++;
+  }
+  return count;
+}
+//// END (I)
+
+
+//// BEGIN (J)
+// Empties the list and returns its nodes as a NULL terminated chain
+static struct Node* CircularLinkedList_detach(struct CircularLinkedList* p_list) {
+  if (p_list->size == 0) {
+    return NULL;
+  }
+  struct Node* p_first = p_list->p_last->p_next;
+  p_list->p_last->p_next = NULL;
+  p_list->p_last = NULL;
+  p_list->size = 0;
+  return p_first;
+}
+
+// Makes the list hold the NULL terminated chain that starts after p_head and ends at p_tail
+static void CircularLinkedList_attach(struct CircularLinkedList* p_list, struct Node* p_head, struct Node* p_tail, size_t size) {
+  if (size == 0) {
+    p_list->p_last = NULL;
+  } else {
+    p_tail->p_next = p_head->p_next;
+    p_list->p_last = p_tail;
+  }
+  p_list->size = size;
+}
+
+void CircularLinkedList_merge(struct CircularLinkedList* p_destination, struct CircularLinkedList* p_source) {
+  assert(p_destination != NULL && "List 1 is NULL");
+  assert(p_source != NULL && "List 2 is NULL");
+  assert(p_destination != p_source && "Lists must be different");
+
+  CircularLinkedList_evictInline(p_source, p_source->p_last, p_source->size, p_destination);
+  CircularLinkedList_outgrowInline(p_destination, p_source->size);
+  size_t size = p_destination->size + p_source->size;
+  p_destination->linked += p_source->size;
+  struct Node* p_last1 = p_destination->p_last;
+  struct Node* p_last2 = p_source->p_last;
+  struct Node* p_current1 = CircularLinkedList_detach(p_destination);
+  struct Node* p_current2 = CircularLinkedList_detach(p_source);
+  FINGERPRINT_MOVE(p_destination, p_source);
+
+  // Relink nodes in order after a dummy head. On ties, destination nodes go first
+  struct Node head;
+  struct Node* p_tail = &head;
+  while (p_current1 != NULL && p_current2 != NULL) {
+    if (p_current2->element < p_current1->element) {
+      p_tail->p_next = p_current2;
+      p_current2 = p_current2->p_next;
+    } else {
+      p_tail->p_next = p_current1;
+      p_current1 = p_current1->p_next;
+    }
+    p_tail = p_tail->p_next;
+  }
+
+  // Append what is left of either list. Its last node is the last node overall
+  if (p_current1 != NULL) {
+    p_tail->p_next = p_current1;
+    p_tail = p_last1;
+  } else if (p_current2 != NULL) {
+    p_tail->p_next = p_current2;
+    p_tail = p_last2;
+  }
+
+  CircularLinkedList_attach(p_destination, &head, p_tail, size);
+  SELF_CHECK(p_destination);
+  SELF_CHECK(p_source);
+}
+
+void CircularLinkedList_union_into(struct CircularLinkedList* p_destination, struct CircularLinkedList* p_source) {
+  assert(p_destination != NULL && "List 1 is NULL");
+  assert(p_source != NULL && "List 2 is NULL");
+  assert(p_destination != p_source && "Lists must be different");
+
+  CircularLinkedList_evictInline(p_source, p_source->p_last, p_source->size, p_destination);
+  CircularLinkedList_outgrowInline(p_destination, p_source->size);
+  size_t size = p_destination->size + p_source->size;
+  size_t linked = p_source->size; // source nodes that are not dropped
+  struct Node* p_last1 = p_destination->p_last;
+  struct Node* p_last2 = p_source->p_last;
+  struct Node* p_current1 = CircularLinkedList_detach(p_destination);
+  struct Node* p_current2 = CircularLinkedList_detach(p_source);
+  FINGERPRINT_MOVE(p_destination, p_source);
+
+  // Relink nodes in order after a dummy head. Each pair of equal elements
+  // keeps the destination node and frees the source one
+  struct Node head;
+  struct Node* p_tail = &head;
+  while (p_current1 != NULL && p_current2 != NULL) {
+    if (p_current2->element < p_current1->element) {
+      p_tail->p_next = p_current2;
+      p_current2 = p_current2->p_next;
+    } else {
+      if (p_current2->element == p_current1->element) {
+        struct Node* p_toDelete = p_current2;
+        p_current2 = p_current2->p_next;
+        FINGERPRINT_SUBTRACT(p_destination, p_toDelete->element);
+        CircularLinkedList_releaseNode(p_destination, p_toDelete);
+        size--;
+        linked--;
+      }
+      p_tail->p_next = p_current1;
+      p_current1 = p_current1->p_next;
+    }
+    p_tail = p_tail->p_next;
+  }
+
+  // Append what is left of either list. Its last node is the last node overall
+  if (p_current1 != NULL) {
+    p_tail->p_next = p_current1;
+    p_tail = p_last1;
+  } else if (p_current2 != NULL) {
+    p_tail->p_next = p_current2;
+    p_tail = p_last2;
+  }
+
+  p_destination->linked += linked;
+  CircularLinkedList_attach(p_destination, &head, p_tail, size);
+  SELF_CHECK(p_destination);
+  SELF_CHECK(p_source);
+}
+
+void CircularLinkedList_intersect_into(struct CircularLinkedList* p_destination, const struct CircularLinkedList* p_source) {
+  assert(p_destination != NULL && "List 1 is NULL");
+  assert(p_source != NULL && "List 2 is NULL");
+
+  if (p_destination == p_source) {
+    return;
+  }
+
+  size_t remaining2 = p_source->size;
+  const struct Node* p_current2 = remaining2 == 0 ? NULL : p_source->p_last->p_next;
+  struct Node* p_current1 = CircularLinkedList_detach(p_destination);
+
+  // Keep destination nodes matched by an equal source element, free the rest
+  struct Node head;
+  struct Node* p_tail = &head;
+  size_t size = 0;
+  while (p_current1 != NULL) {
+    if (remaining2 != 0 && p_current2->element < p_current1->element) {
+      p_current2 = p_current2->p_next;
+      remaining2--;
+    } else if (remaining2 != 0 && p_current2->element == p_current1->element) {
+      p_tail->p_next = p_current1;
+      p_tail = p_current1;
+      p_current1 = p_current1->p_next;
+      p_current2 = p_current2->p_next;
+      remaining2--;
+      size++;
+    } else {
+      struct Node* p_toDelete = p_current1;
+      p_current1 = p_current1->p_next;
+      FINGERPRINT_SUBTRACT(p_destination, p_toDelete->element);
+      CircularLinkedList_releaseNode(p_destination, p_toDelete);
+    }
+  }
+
+  CircularLinkedList_attach(p_destination, &head, p_tail, size);
+  SELF_CHECK(p_destination);
+}
+//// END (J)
+
+
+//// BEGIN (K)
+#ifdef CIRCULAR_LINKED_LIST_FINGERPRINT
+// Sum of the hashes of count nodes starting at p_first
+static uint64_t CircularLinkedList_hashChain(const struct Node* p_first, size_t count) {
+  uint64_t fingerprint = 0;
+  const struct Node* p_current = p_first;
+  for (size_t i = 0; i < count; i++) {
+    fingerprint += CircularLinkedList_hashElement(p_current->element);
+    p_current = p_current->p_next;
+  }
+  return fingerprint;
+}
+#endif
+
+// Links the chain p_first..p_last (count nodes) at the beginning or the end
+// of the list, depending on where its values belong
+static void CircularLinkedList_linkChain(struct CircularLinkedList* p_list, struct Node* p_first, struct Node* p_last, size_t count) {
+  if (p_list->size == 0) {
+    p_last->p_next = p_first;
+    p_list->p_last = p_last;
+  } else {
+    bool append = p_first->element >= p_list->p_last->element;
+    assert((append || p_last->element <= p_list->p_last->p_next->element) && "Lists overlap");
+
+    // Same links either way: only the last node differs
+    p_last->p_next = p_list->p_last->p_next;
+    p_list->p_last->p_next = p_first;
+    if (append) {
+      p_list->p_last = p_last;
+    }
+  }
+  p_list->size += count;
+  p_list->linked += count;
+}
+
+// Unlinks the count (> 0) nodes that follow p_previous. Returns the first of
+// them and stores the last one in *p_p_last
+static struct Node* CircularLinkedList_unlinkRange(struct CircularLinkedList* p_list, struct Node* p_previous, size_t count, struct Node** p_p_last) {
+  // Find the last node of the range
+  struct Node* p_first = p_previous->p_next;
+  struct Node* p_last = p_first;
+  FINGERPRINT_SUBTRACT(p_list, p_first->element);
+  for (size_t i = 1; i < count; i++) {
+    p_last = p_last->p_next;
+    FINGERPRINT_SUBTRACT(p_list, p_last->element);
+  }
+
+  // Unlink the range from the list
+  if (count == p_list->size) {
+    p_list->p_last = NULL;
+  } else {
+    p_previous->p_next = p_last->p_next;
+    if (p_last == p_list->p_last) {
+      p_list->p_last = p_previous;
+    }
+  }
+  p_list->size -= count;
+
+  *p_p_last = p_last;
+  return p_first;
+}
+
+void CircularLinkedList_concat(struct CircularLinkedList* p_destination, struct CircularLinkedList* p_source) {
+  assert(p_destination != NULL && "List 1 is NULL");
+  assert(p_source != NULL && "List 2 is NULL");
+  assert(p_destination != p_source && "Lists must be different");
+
+  if (p_source->size == 0) {
+    return;
+  }
+
+  CircularLinkedList_evictInline(p_source, p_source->p_last, p_source->size, p_destination);
+  CircularLinkedList_outgrowInline(p_destination, p_source->size);
+  CircularLinkedList_linkChain(p_destination, p_source->p_last->p_next, p_source->p_last, p_source->size);
+  FINGERPRINT_MOVE(p_destination, p_source);
+  p_source->p_last = NULL;
+  p_source->size = 0;
+  SELF_CHECK(p_destination);
+  SELF_CHECK(p_source);
+}
+
+void CircularLinkedList_split_at_node(struct CircularLinkedList* p_destination, struct CircularLinkedList* p_source, const struct CircularLinkedList_Cursor* p_cursor) {
+  assert(p_destination != NULL && "List 1 is NULL");
+  assert(p_source != NULL && "List 2 is NULL");
+  assert(p_cursor != NULL && "Cursor is NULL");
+  assert(p_destination != p_source && "Lists must be different");
+  assert(p_destination->size == 0 && "Destination list is not empty");
+  assert(p_cursor->index <= p_source->size && "Cursor out of bounds");
+
+  size_t count = p_source->size - p_cursor->index;
+  if (count == 0) {
+    return;
+  }
+
+  // Nodes from the cursor to the end of the source go to the destination
+  CircularLinkedList_evictInline(p_source, p_cursor->p_previous, count, p_destination);
+  struct Node* p_first = p_source->p_last->p_next;
+  struct Node* p_previous = p_cursor->p_previous;
+#ifdef CIRCULAR_LINKED_LIST_FINGERPRINT
+  // Hash whichever part is shorter and derive the other one
+  uint64_t moved;
+  if (count <= p_cursor->index) {
+    moved = CircularLinkedList_hashChain(p_previous->p_next, count);
+  } else {
+    moved = p_source->fingerprint - CircularLinkedList_hashChain(p_first, p_cursor->index);
+  }
+  p_destination->fingerprint = moved;
+  p_source->fingerprint -= moved;
+#endif
+  p_destination->p_last = p_source->p_last;
+  p_destination->size = count;
+  p_destination->linked += count;
+
+  if (count == p_source->size) {
+    p_source->p_last = NULL;
+  } else {
+    p_source->p_last->p_next = p_previous->p_next;
+    p_previous->p_next = p_first;
+    p_source->p_last = p_previous;
+  }
+  p_source->size -= count;
+  SELF_CHECK(p_destination);
+  SELF_CHECK(p_source);
+}
+
+void CircularLinkedList_splice_range(struct CircularLinkedList* p_destination, struct CircularLinkedList* p_source, const struct CircularLinkedList_Cursor* p_cursor, size_t count) {
+  assert(p_destination != NULL && "List 1 is NULL");
+  assert(p_source != NULL && "List 2 is NULL");
+  assert(p_cursor != NULL && "Cursor is NULL");
+  assert(p_destination != p_source && "Lists must be different");
+  assert(p_cursor->index + count <= p_source->size && "Range out of bounds");
+
+  if (count == 0) {
+    return;
+  }
+
+  // A cursor at index 0 follows the last node, which eviction may replace
+  CircularLinkedList_evictInline(p_source, p_cursor->p_previous, count, p_destination);
+  CircularLinkedList_outgrowInline(p_destination, count);
+  struct Node* p_previous = p_cursor->index == 0 ? p_source->p_last : p_cursor->p_previous;
+
+#ifdef CIRCULAR_LINKED_LIST_FINGERPRINT
+  uint64_t fingerprint = p_source->fingerprint;
+#endif
+  struct Node* p_last;
+  struct Node* p_first = CircularLinkedList_unlinkRange(p_source, p_previous, count, &p_last);
+#ifdef CIRCULAR_LINKED_LIST_FINGERPRINT
+  // unlinkRange subtracted the hashes of the moved nodes from the source
+  p_destination->fingerprint += fingerprint - p_source->fingerprint;
+#endif
+
+  CircularLinkedList_linkChain(p_destination, p_first, p_last, count);
+  SELF_CHECK(p_destination);
+  SELF_CHECK(p_source);
+}
+//// END (K)
+
+
+//// BEGIN (L)
+// Releases count nodes of a chain that belonged to p_list
+static void CircularLinkedList_releaseNodes(struct CircularLinkedList* p_list, struct Node* p_first, size_t count) {
+  struct Node* p_current = p_first;
+  for (size_t i = 0; i < count; i++) {
+    struct Node* p_toDelete = p_current;
+    p_current = p_current->p_next;
+    CircularLinkedList_releaseNode(p_list, p_toDelete);
+  }
+}
+
+void CircularLinkedList_remove_range(struct CircularLinkedList* p_list, size_t from, size_t to) {
+  assert(p_list != NULL && "List is NULL");
+  assert(from <= to && to <= p_list->size && "Range out of bounds");
+
+  if (from == to) {
+    return;
+  }
+
+  // Find the node before the range
+  struct Node* p_previous = p_list->p_last;
+  for (size_t i = 0; i < from; i++) {
+    p_previous = p_previous->p_next;
+  }
+
+  struct Node* p_last;
+  struct Node* p_first = CircularLinkedList_unlinkRange(p_list, p_previous, to - from, &p_last);
+  CircularLinkedList_releaseNodes(p_list, p_first, to - from);
+  SELF_CHECK(p_list);
+}
+
+size_t CircularLinkedList_remove_if(struct CircularLinkedList* p_list, bool (*p_predicate)(int element, void* p_context), void* p_context) {
+  assert(p_list != NULL && "List is NULL");
+  assert(p_predicate != NULL && "Predicate is NULL");
+
+  // Unlink matching nodes and chain them together to be released at the end
+  struct Node* p_previous = p_list->p_last; // Last node kept so far
+  struct Node head;
+  struct Node* p_removed = &head;
+  size_t kept = 0;
+  for (size_t i = 0; i < p_list->size; i++) {
+    struct Node* p_current = p_previous->p_next;
+    if (p_predicate(p_current->element, p_context)) {
+      FINGERPRINT_SUBTRACT(p_list, p_current->element);
+      p_previous->p_next = p_current->p_next;
+      p_removed->p_next = p_current;
+      p_removed = p_current;
+    } else {
+      p_previous = p_current;
+      kept++;
+    }
+  }
+
+  // The last node kept is the new last node
+  size_t removed = p_list->size - kept;
+  p_list->p_last = kept == 0 ? NULL : p_previous;
+  p_list->size = kept;
+
+  CircularLinkedList_releaseNodes(p_list, head.p_next, removed);
+  SELF_CHECK(p_list);
+  return removed;
+}
+
+size_t CircularLinkedList_remove_value(struct CircularLinkedList* p_list, int element) {
+  assert(p_list != NULL && "List is NULL");
+
+  // Equal elements are adjacent: find the first one and count the run
+  struct CircularLinkedList_Cursor cursor = CircularLinkedList_lower_bound(p_list, element);
+  struct Node* p_current = cursor.p_previous == NULL ? NULL : cursor.p_previous->p_next;
+  size_t count = 0;
+  while (cursor.index + count < p_list->size && p_current->element == element) {
+    p_current = p_current->p_next;
+    count++;
+  }
+
+  if (count != 0) {
+    struct Node* p_last;
+    struct Node* p_first = CircularLinkedList_unlinkRange(p_list, cursor.p_previous, count, &p_last);
+    CircularLinkedList_releaseNodes(p_list, p_first, count);
+  }
+  SELF_CHECK(p_list);
+  return count;
+}
+//// END (L)
+
+
+//// BEGIN (M)
+#define MAX_ELEMENT_LENGTH 12  // "-2147483648 "
+#define WRITE_BUFFER_SIZE 8192
+
+static const char digitPairs[] =
+  "0001020304050607080910111213141516171819"
+  "2021222324252627282930313233343536373839"
+  "4041424344454647484950515253545556575859"
+  "6061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+
+// Writes element in decimal followed by a space, two digits at a time.
+// Returns the number of characters written (at most MAX_ELEMENT_LENGTH)
+static size_t CircularLinkedList_formatElement(int element, char* p_out) {
+  char digits[10];
+  char* p_digit = digits + sizeof(digits);
+  unsigned value = element < 0 ? 0u - (unsigned) element : (unsigned) element;
+
+  while (value >= 100) {
+    unsigned pair = (value % 100) * 2;
+    value /= 100;
+    *--p_digit = digitPairs[pair + 1];
+    *--p_digit = digitPairs[pair];
+  }
+  if (value >= 10) {
+    *--p_digit = digitPairs[value * 2 + 1];
+    *--p_digit = digitPairs[value * 2];
+  } else {
+    *--p_digit = (char) ('0' + value);
+  }
+
+  size_t length = 0;
+  if (element < 0) {
+    p_out[length++] = '-';
+  }
+  size_t count = (size_t) (digits + sizeof(digits) - p_digit);
+  memcpy(p_out + length, p_digit, count);
+  length += count;
+  p_out[length++] = ' ';
+  return length;
+}
+
+bool CircularLinkedList_write(const struct CircularLinkedList* p_list, FILE* p_file) {
+  assert(p_list != NULL && "List is NULL");
+  assert(p_file != NULL && "File is NULL");
+
+  // Format into a local buffer and hand it to stdio in large chunks
+  char buffer[WRITE_BUFFER_SIZE];
+  size_t used = 0;
+  int element;
+  CircularLinkedList_for_each(element, p_list) {
+    if (used + MAX_ELEMENT_LENGTH + 1 > sizeof(buffer)) {
+      fwrite(buffer, 1, used, p_file);
+      used = 0;
+    }
+    used += CircularLinkedList_formatElement(element, buffer + used);
+  }
+  buffer[used++] = '\n';
+  fwrite(buffer, 1, used, p_file);
+
+  return !ferror(p_file);
+}
+
+size_t CircularLinkedList_to_buffer(const struct CircularLinkedList* p_list, char* p_buffer, size_t size) {
+  assert(p_list != NULL && "List is NULL");
+  assert((p_buffer != NULL || size == 0) && "Buffer is NULL");
+
+  size_t length = 0;
+  int element;
+  CircularLinkedList_for_each(element, p_list) {
+    if (length + MAX_ELEMENT_LENGTH < size) {
+      // Enough room: format in place
+      length += CircularLinkedList_formatElement(element, p_buffer + length);
+    } else {
+      // Close to the end: format aside and copy what fits
+      char text[MAX_ELEMENT_LENGTH];
+      size_t count = CircularLinkedList_formatElement(element, text);
+      if (length < size) {
+        size_t room = size - 1 - length;
+        memcpy(p_buffer + length, text, count < room ? count : room);
+      }
+      length += count;
+    }
+  }
+  if (length + 1 < size) {
+    p_buffer[length] = '\n';
+  }
+  length++;
+
+  if (size != 0) {
+    p_buffer[length < size ? length : size - 1] = '\0';
+  }
+  return length;
+}
+//// END (M)
+
+
+//// BEGIN (N)
+#define SNAPSHOT_MAGIC "CLLS"
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_HEADER_SIZE 24
+#define SNAPSHOT_RAW 0
+#define SNAPSHOT_DELTA 1
+#define MAX_VARINT_LENGTH 5
+
+static void storeLittleEndian(unsigned char* p_out, uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; i++) {
+    p_out[i] = (unsigned char) (value >> (8 * i));
+  }
+}
+
+static uint64_t loadLittleEndian(const unsigned char* p_in, int bytes) {
+  uint64_t value = 0;
+  for (int i = 0; i < bytes; i++) {
+    value |= (uint64_t) p_in[i] << (8 * i);
+  }
+  return value;
+}
+
+static size_t varintLength(uint32_t value) {
+  size_t length = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    length++;
+  }
+  return length;
+}
+
+bool CircularLinkedList_save(const struct CircularLinkedList* p_list, const char* p_path) {
+  assert(p_list != NULL && "List is NULL");
+  assert(p_path != NULL && "Path is NULL");
+
+  // Choose the encoding. Deltas between consecutive elements of a sorted list
+  // are non-negative and usually small, so their varints tend to beat raw int32
+  uint64_t delta_size = 0;
+  uint32_t previous = 0;
+  int element;
+  CircularLinkedList_for_each(element, p_list) {
+    delta_size += varintLength((uint32_t) element - previous);
+    previous = (uint32_t) element;
+  }
+  uint64_t raw_size = 4 * (uint64_t) p_list->size;
+  int encoding = delta_size < raw_size ? SNAPSHOT_DELTA : SNAPSHOT_RAW;
+
+  FILE* p_file = fopen(p_path, "wb");
+  if (p_file == NULL) {
+    return false;
+  }
+
+  unsigned char buffer[WRITE_BUFFER_SIZE];
+  memcpy(buffer, SNAPSHOT_MAGIC, 4);
+  storeLittleEndian(buffer + 4, SNAPSHOT_VERSION, 2);
+  storeLittleEndian(buffer + 6, (uint64_t) encoding, 2);
+  storeLittleEndian(buffer + 8, p_list->size, 8);
+  storeLittleEndian(buffer + 16, encoding == SNAPSHOT_DELTA ? delta_size : raw_size, 8);
+  size_t used = SNAPSHOT_HEADER_SIZE;
+
+  previous = 0;
+  CircularLinkedList_for_each(element, p_list) {
+    if (used + MAX_VARINT_LENGTH > sizeof(buffer)) {
+      fwrite(buffer, 1, used, p_file);
+      used = 0;
+    }
+    if (encoding == SNAPSHOT_RAW) {
+      storeLittleEndian(buffer + used, (uint32_t) element, 4);
+      used += 4;
+    } else {
+      uint32_t delta = (uint32_t) element - previous;
+      while (delta >= 0x80) {
+        buffer[used++] = (unsigned char) (delta | 0x80);
+        delta >>= 7;
+      }
+      buffer[used++] = (unsigned char) delta;
+      previous = (uint32_t) element;
+    }
+  }
+  fwrite(buffer, 1, used, p_file);
+
+  bool ok = !ferror(p_file);
+  return fclose(p_file) == 0 && ok;
+}
+
+// Builds a list from a snapshot held in memory, in a single pass over nodes
+// allocated at once. Returns NULL if the snapshot is malformed or its
+// elements are not sorted
+static struct CircularLinkedList* CircularLinkedList_decode(const unsigned char* p_data, size_t length) {
+  if (length < SNAPSHOT_HEADER_SIZE || memcmp(p_data, SNAPSHOT_MAGIC, 4) != 0 || loadLittleEndian(p_data + 4, 2) != SNAPSHOT_VERSION) {
+    return NULL;
+  }
+  uint64_t encoding = loadLittleEndian(p_data + 6, 2);
+  uint64_t count = loadLittleEndian(p_data + 8, 8);
+  uint64_t payload_size = loadLittleEndian(p_data + 16, 8);
+  // Sizes are compared by dividing, as 4 * count may overflow
+  if (payload_size != length - SNAPSHOT_HEADER_SIZE
+      || (encoding == SNAPSHOT_RAW && (count > payload_size / 4 || payload_size % 4 != 0))
+      || (encoding == SNAPSHOT_DELTA && count > payload_size)
+      || encoding > SNAPSHOT_DELTA) {
+    return NULL;
+  }
+
+  const unsigned char* p_payload = p_data + SNAPSHOT_HEADER_SIZE;
+  size_t position = 0;
+  uint32_t value = 0;
+  struct CircularLinkedList* p_list = CircularLinkedList_new();
+  struct Node* p_nodes = count == 0 ? NULL : CircularLinkedList_allocateNodes(p_list, (size_t) count);
+
+  for (uint64_t i = 0; i < count; i++) {
+    int previous = (int) value;
+    if (encoding == SNAPSHOT_RAW) {
+      value = (uint32_t) loadLittleEndian(p_payload + position, 4);
+      position += 4;
+    } else {
+      // Decode a varint delta, rejecting overlong or truncated ones
+      uint32_t delta = 0;
+      int shift = 0;
+      unsigned char byte;
+      do {
+        if (position >= payload_size || shift >= 7 * MAX_VARINT_LENGTH) {
+          CircularLinkedList_discardNodes(p_list, p_nodes);
+          CircularLinkedList_free(&p_list);
+          return NULL;
+        }
+        byte = p_payload[position++];
+        delta |= (uint32_t) (byte & 0x7F) << shift;
+        shift += 7;
+      } while (byte & 0x80);
+      value += delta;
+    }
+
+    if (i != 0 && (int) value < previous) {
+      CircularLinkedList_discardNodes(p_list, p_nodes);
+      CircularLinkedList_free(&p_list);
+      return NULL;
+    }
+    p_nodes[i].element = (int) value;
+    p_nodes[i].p_next = &p_nodes[i + 1];
+    FINGERPRINT_ADD(p_list, (int) value);
+  }
+  if (count != 0) {
+    CircularLinkedList_adoptNodes(p_list, p_nodes, (size_t) count);
+  }
+
+  if (position != payload_size) {
+    CircularLinkedList_free(&p_list);
+    return NULL;
+  }
+  return p_list;
+}
+
+struct CircularLinkedList* CircularLinkedList_load(const char* p_path) {
+  assert(p_path != NULL && "Path is NULL");
+
+  struct CircularLinkedList* p_list = NULL;
+#ifndef _WIN32
+  // Map the file so that decoding streams straight from the page cache
+  int fd = open(p_path, O_RDONLY);
+  if (fd < 0) {
+    return NULL;
+  }
+  struct stat info;
+  if (fstat(fd, &info) == 0 && info.st_size >= SNAPSHOT_HEADER_SIZE) {
+    size_t length = (size_t) info.st_size;
+    void* p_data = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p_data != MAP_FAILED) {
+      madvise(p_data, length, MADV_SEQUENTIAL);
+      p_list = CircularLinkedList_decode(p_data, length);
+      munmap(p_data, length);
+    }
+  }
+  close(fd);
+#else
+  FILE* p_file = fopen(p_path, "rb");
+  if (p_file == NULL) {
+    return NULL;
+  }
+  if (fseek(p_file, 0, SEEK_END) == 0) {
+    long length = ftell(p_file);
+    unsigned char* p_data = length >= SNAPSHOT_HEADER_SIZE ? malloc((size_t) length) : NULL;
+    if (p_data != NULL) {
+      rewind(p_file);
+      if (fread(p_data, 1, (size_t) length, p_file) == (size_t) length) {
+        p_list = CircularLinkedList_decode(p_data, (size_t) length);
+      }
+      free(p_data);
+    }
+  }
+  fclose(p_file);
+#endif
+  return p_list;
+}
+//// END (N)
+
+
+//// BEGIN (O)
+#ifdef CIRCULAR_LINKED_LIST_FINGERPRINT
+uint64_t CircularLinkedList_fingerprint(const struct CircularLinkedList* p_list) {
+  assert(p_list != NULL && "List is NULL");
+
+  return p_list->fingerprint;
+}
+
+uint64_t CircularLinkedList_rehash(struct CircularLinkedList* p_list) {
+  assert(p_list != NULL && "List is NULL");
+
+  p_list->fingerprint = p_list->size == 0 ? 0 : CircularLinkedList_hashChain(p_list->p_last->p_next, p_list->size);
+  return p_list->fingerprint;
+}
+#else
+uint64_t CircularLinkedList_fingerprint(const struct CircularLinkedList* p_list) {
+  assert(p_list != NULL && "List is NULL");
+
+  uint64_t fingerprint = 0;
+  int element;
+  CircularLinkedList_for_each(element, p_list) {
+    fingerprint += CircularLinkedList_hashElement(element);
+  }
+  return fingerprint;
+}
+#endif
+//// END (O)
+
+
+//// BEGIN (P)
+void CircularLinkedList_compact(struct CircularLinkedList* p_list) {
+  assert(p_list != NULL && "List is NULL");
+
+  p_list->traversed = 0;
+  p_list->linked = 0;
+  if (p_list->size == 0) {
+    return;
+  }
+
+  // Copy the elements in order into consecutive nodes, releasing the old ones
+  struct Node* p_nodes = CircularLinkedList_allocateBlock(p_list->size);
+  struct Node* p_current = p_list->p_last->p_next;
+  for (size_t i = 0; i < p_list->size; i++) {
+    struct Node* p_toDelete = p_current;
+    p_current = p_current->p_next;
+    p_nodes[i].element = p_toDelete->element;
+    p_nodes[i].p_next = &p_nodes[i + 1];
+    CircularLinkedList_releaseNode(p_list, p_toDelete);
+  }
+
+  // Close the cycle
+  p_nodes[p_list->size - 1].p_next = p_nodes;
+  p_list->p_last = &p_nodes[p_list->size - 1];
+  SELF_CHECK(p_list);
+}
+
+void CircularLinkedList_set_auto_compact(struct CircularLinkedList* p_list, size_t ratio) {
+  assert(p_list != NULL && "List is NULL");
+
+  p_list->compact_ratio = ratio;
+  p_list->traversed = 0;
+}
+//// END (P)
+
+
+//// BEGIN (Q)
+struct CircularLinkedList* CircularLinkedList_clone(const struct CircularLinkedList* p_list) {
+  assert(p_list != NULL && "List is NULL");
+
+  // Copy the elements in order into consecutive nodes, linking each one as it is written
+  struct CircularLinkedList* p_clone = CircularLinkedList_new();
+  if (p_list->size != 0) {
+    struct Node* p_nodes = CircularLinkedList_allocateNodes(p_clone, p_list->size);
+    const struct Node* p_current = p_list->p_last->p_next;
+    for (size_t i = 0; i < p_list->size; i++) {
+      p_nodes[i].element = p_current->element;
+      p_nodes[i].p_next = &p_nodes[i + 1];
+      p_current = p_current->p_next;
+    }
+    CircularLinkedList_adoptNodes(p_clone, p_nodes, p_list->size);
+  }
+#ifdef CIRCULAR_LINKED_LIST_FINGERPRINT
+  p_clone->fingerprint = p_list->fingerprint;
+#endif
+  SELF_CHECK(p_clone);
+  return p_clone;
+}
+//// END (Q)
+
+
+//// BEGIN (R)
+void CircularLinkedList_clear(struct CircularLinkedList* p_list) {
+  assert(p_list != NULL && "List is NULL");
+
+  if (p_list->size != 0 && p_list->inline_used == 0) {
+    // Open the cycle after the last node and put the whole chain in front of
+    // the kept nodes
+    struct Node* p_first = p_list->p_last->p_next;
+    p_list->p_last->p_next = p_list->p_free;
+    p_list->p_free = p_first;
+    p_list->free_count += p_list->size;
+  } else if (p_list->size != 0) {
+    // A small list: keep its heap nodes one by one, as inline nodes are only
+    // freed, so that they never leave the list structure
+    struct Node* p_current = p_list->p_last->p_next;
+    for (size_t i = 0; i < p_list->size; i++) {
+      struct Node* p_next = p_current->p_next;
+      if (!CircularLinkedList_isInline(p_list, p_current)) {
+        p_current->p_next = p_list->p_free;
+        p_list->p_free = p_current;
+        p_list->free_count++;
+      }
+      p_current = p_next;
+    }
+    p_list->inline_used = 0;
+  }
+
+  p_list->p_last = NULL;
+  p_list->size = 0;
+  p_list->traversed = 0;
+  p_list->linked = 0;
+#ifdef CIRCULAR_LINKED_LIST_FINGERPRINT
+  p_list->fingerprint = 0;
+#endif
+  SELF_CHECK(p_list);
+}
+
+void CircularLinkedList_reserve(struct CircularLinkedList* p_list, size_t n) {
+  assert(p_list != NULL && "List is NULL");
+
+  // Nodes in the list or available without allocating: kept ones, and free
+  // inline nodes if n elements fit in a list that keeps inline nodes. Else
+  // the inline nodes in use will have to move to kept ones
+  size_t available = p_list->size + p_list->free_count;
+  for (unsigned i = 0; i < CIRCULAR_LINKED_LIST_INLINE_NODES; i++) {
+    bool used = (p_list->inline_used & (1u << i)) != 0;
+    if (n <= CIRCULAR_LINKED_LIST_INLINE_LIMIT && !used) {
+      available++;
+    } else if (n > CIRCULAR_LINKED_LIST_INLINE_LIMIT && used) {
+      available--;
+    }
+  }
+  if (available >= n) {
+    return;
+  }
+
+  // Keep the missing nodes, all from a single block
+  size_t count = n - available;
+  struct Node* p_nodes = CircularLinkedList_allocateBlock(count);
+  for (size_t i = 0; i + 1 < count; i++) {
+    p_nodes[i].p_next = &p_nodes[i + 1];
+  }
+  p_nodes[count - 1].p_next = p_list->p_free;
+  p_list->p_free = p_nodes;
+  p_list->free_count += count;
+}
+//// END (R)
+
+
+//// BEGIN (S)
+#ifdef CIRCULAR_LINKED_LIST_STATS
+const struct CircularLinkedList_Stats* CircularLinkedList_stats(void) {
+  return &stats;
+}
+
+void CircularLinkedList_reset_stats(void) {
+  memset(&stats, 0, sizeof(stats));
+}
+
+static void CircularLinkedList_writeOperationStats(FILE* p_file, const char* p_name, const struct CircularLinkedList_OperationStats* p_stats) {
+  fprintf(p_file, "\"%s\": {\"calls\": %llu, \"visited\": %llu, \"max\": %llu, \"histogram\": [",
+          p_name, (unsigned long long) p_stats->calls, (unsigned long long) p_stats->visited, (unsigned long long) p_stats->max);
+  for (size_t i = 0; i < CIRCULAR_LINKED_LIST_STATS_BUCKETS; i++) {
+    fprintf(p_file, i == 0 ? "%llu" : ", %llu", (unsigned long long) p_stats->histogram[i]);
+  }
+  fprintf(p_file, "]}");
+}
+
+bool CircularLinkedList_write_stats_json(FILE* p_file) {
+  assert(p_file != NULL && "File is NULL");
+
+  fprintf(p_file, "{");
+  CircularLinkedList_writeOperationStats(p_file, "insert", &stats.insert);
+  fprintf(p_file, ", ");
+  CircularLinkedList_writeOperationStats(p_file, "remove", &stats.remove);
+  fprintf(p_file, ", ");
+  CircularLinkedList_writeOperationStats(p_file, "equals", &stats.equals);
+  fprintf(p_file, "}\n");
+  return !ferror(p_file);
+}
+#endif
+//// END (S)
+
+
+//// BEGIN (T)
+#ifdef CIRCULAR_LINKED_LIST_TRACE
+void CircularLinkedList_set_trace(FILE* p_file) {
+  p_trace = p_file;
+}
+#endif
+//// END (T)
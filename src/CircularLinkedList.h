@@ -5,15 +5,44 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
 
+// The block field fills the padding after element on 64-bit targets, where a
+// node takes 16 bytes either way. With 32-bit pointers it grows a node from 8
+// to 12 bytes, the price of freeing blocks from any of their nodes
 struct Node {
   int element;         // element in the node
+  uint32_t block;      // 1 + position of the node in its block (see compact), 0 if allocated alone
   struct Node* p_next; // pointer to the next node
 };
 
+// Number of nodes stored in the list structure itself. Insertions use them
+// before allocating nodes on the heap, so small lists need no allocations.
+// Lists only keep inline nodes while they have at most INLINE_LIMIT nodes,
+// moving them to the heap when they grow larger, so that inline nodes are
+// found in O(1) when they have to leave the list structure
+#define CIRCULAR_LINKED_LIST_INLINE_NODES 3
+#define CIRCULAR_LINKED_LIST_INLINE_LIMIT (2 * CIRCULAR_LINKED_LIST_INLINE_NODES)
+
+// Lists are allocated at cache line boundaries, and the structure fits in
+// two cache lines: the counters in the first one, the inline nodes in the
+// second one
+#define CIRCULAR_LINKED_LIST_ALIGNMENT 64
+
 struct CircularLinkedList {
-  struct Node* p_last; // pointer to the last node
+  _Alignas(CIRCULAR_LINKED_LIST_ALIGNMENT) struct Node* p_last; // pointer to the last node
   size_t size;         // number of elements in the list
+  size_t traversed;     // nodes visited by insert and remove searches since the last compaction
+  size_t linked;        // nodes linked into the list since the last compaction
+  size_t compact_ratio; // compact when traversed reaches compact_ratio * (size + linked) (0: never)
+  struct Node* p_free;  // nodes kept for reuse by clear and reserve, linked by p_next
+  size_t free_count;    // number of nodes in p_free
+  unsigned inline_used; // bit i is set while inline_nodes[i] is in the list
+  struct Node inline_nodes[CIRCULAR_LINKED_LIST_INLINE_NODES]; // nodes stored in place
+#ifdef CIRCULAR_LINKED_LIST_FINGERPRINT
+  uint64_t fingerprint; // sum of the hashes of the elements
+#endif
 };
 
 struct CircularLinkedList* CircularLinkedList_new();
@@ -23,4 +52,199 @@ void CircularLinkedList_print(const struct CircularLinkedList* p_list);
 void CircularLinkedList_free(struct CircularLinkedList** p_p_list);
 bool CircularLinkedList_equals(const struct CircularLinkedList* p_list1, const struct CircularLinkedList* p_list2);
 
+// A cursor designates a position in a list. It stays valid across operations
+// performed through it, even if they compact the list, but any other
+// modification of the list invalidates it
+struct CircularLinkedList_Cursor {
+  struct Node* p_previous; // node before the cursor position (p_last for the first node, NULL if list is empty)
+  size_t index;            // index of the node at the cursor position
+};
+
+struct CircularLinkedList_Cursor CircularLinkedList_cursor_begin(const struct CircularLinkedList* p_list);
+void CircularLinkedList_cursor_next(const struct CircularLinkedList* p_list, struct CircularLinkedList_Cursor* p_cursor);
+int CircularLinkedList_cursor_element(const struct CircularLinkedList* p_list, const struct CircularLinkedList_Cursor* p_cursor);
+void CircularLinkedList_insert_at_hint(struct CircularLinkedList* p_list, struct CircularLinkedList_Cursor* p_cursor, int element);
+void CircularLinkedList_remove_at_cursor(struct CircularLinkedList* p_list, struct CircularLinkedList_Cursor* p_cursor);
+
+// An iterator visits the elements from the first node exactly size times. While
+// doing so, it prefetches the node CIRCULAR_LINKED_LIST_PREFETCH_DISTANCE links
+// ahead, so that work done on each element overlaps with fetching later nodes
+#ifndef CIRCULAR_LINKED_LIST_PREFETCH_DISTANCE
+#define CIRCULAR_LINKED_LIST_PREFETCH_DISTANCE 4
+#endif
+
+#if defined(__GNUC__)
+#define CIRCULAR_LINKED_LIST_PREFETCH(p_node) __builtin_prefetch((p_node), 0, 1)
+#else
+#define CIRCULAR_LINKED_LIST_PREFETCH(p_node) ((void) (p_node))
+#endif
+
+struct CircularLinkedList_Iterator {
+  const struct Node* p_current; // node holding the next element to visit
+  const struct Node* p_ahead;   // node being prefetched, some links ahead of p_current
+  size_t remaining;             // number of elements not visited yet
+};
+
+static inline struct CircularLinkedList_Iterator CircularLinkedList_iterator_begin(const struct CircularLinkedList* p_list) {
+  struct CircularLinkedList_Iterator iterator = { NULL, NULL, p_list->size };
+  if (p_list->size != 0) {
+    iterator.p_current = p_list->p_last->p_next;
+    iterator.p_ahead = iterator.p_current;
+    for (int i = 0; i < CIRCULAR_LINKED_LIST_PREFETCH_DISTANCE; i++) {
+      iterator.p_ahead = iterator.p_ahead->p_next;
+      CIRCULAR_LINKED_LIST_PREFETCH(iterator.p_ahead);
+    }
+  }
+  return iterator;
+}
+
+static inline bool CircularLinkedList_iterator_has_next(const struct CircularLinkedList_Iterator* p_iterator) {
+  return p_iterator->remaining != 0;
+}
+
+static inline int CircularLinkedList_iterator_next(struct CircularLinkedList_Iterator* p_iterator) {
+  // The list is circular, so the prefetched node wraps around instead of running off the end
+  p_iterator->p_ahead = p_iterator->p_ahead->p_next;
+  CIRCULAR_LINKED_LIST_PREFETCH(p_iterator->p_ahead);
+
+  int element = p_iterator->p_current->element;
+  p_iterator->p_current = p_iterator->p_current->p_next;
+  p_iterator->remaining--;
+  return element;
+}
+
+// Runs the statement that follows once for each element of the list, in
+// order, storing the element in the (previously declared) int variable element
+#define CircularLinkedList_for_each(element, p_list)                                                        \
+  for (struct CircularLinkedList_Iterator iterator_##element = CircularLinkedList_iterator_begin(p_list); \
+       CircularLinkedList_iterator_has_next(&iterator_##element) &&                                       \
+       ((element) = CircularLinkedList_iterator_next(&iterator_##element), true);)
+
+long long CircularLinkedList_sum(const struct CircularLinkedList* p_list);
+size_t CircularLinkedList_count_if(const struct CircularLinkedList* p_list, bool (*p_predicate)(int element, void* p_context), void* p_context);
+int CircularLinkedList_min(const struct CircularLinkedList* p_list);
+int CircularLinkedList_max(const struct CircularLinkedList* p_list);
+
+bool CircularLinkedList_contains(const struct CircularLinkedList* p_list, int element);
+struct CircularLinkedList_Cursor CircularLinkedList_lower_bound(const struct CircularLinkedList* p_list, int element);
+size_t CircularLinkedList_count(const struct CircularLinkedList* p_list, int element);
+
+// Combine two lists in one linear pass. merge and union_into move the nodes
+// of p_source into p_destination and leave p_source empty. Inline nodes (see
+// CIRCULAR_LINKED_LIST_INLINE_NODES) cannot move: the elements of those of
+// p_source go to free inline nodes of a small enough destination or to nodes
+// kept by either list, and those of a destination that outgrows its inline
+// nodes to nodes it keeps. Only failing that are new nodes allocated, at most
+// CIRCULAR_LINKED_LIST_INLINE_NODES per list. Lists are multisets: union keeps the largest number of occurrences
+// of each element and intersection the smallest
+void CircularLinkedList_merge(struct CircularLinkedList* p_destination, struct CircularLinkedList* p_source);
+void CircularLinkedList_union_into(struct CircularLinkedList* p_destination, struct CircularLinkedList* p_source);
+void CircularLinkedList_intersect_into(struct CircularLinkedList* p_destination, const struct CircularLinkedList* p_source);
+
+// Move nodes between lists whose values do not overlap, so that the result
+// stays sorted without comparing elements. concat takes O(1), split_at_node
+// O(1) and splice_range O(count). Inline nodes are handled as in merge, which
+// adds O(1), as lists with inline nodes are small. The non-overlapping
+// precondition is only checked in debug builds
+void CircularLinkedList_concat(struct CircularLinkedList* p_destination, struct CircularLinkedList* p_source);
+void CircularLinkedList_split_at_node(struct CircularLinkedList* p_destination, struct CircularLinkedList* p_source, const struct CircularLinkedList_Cursor* p_cursor);
+void CircularLinkedList_splice_range(struct CircularLinkedList* p_destination, struct CircularLinkedList* p_source, const struct CircularLinkedList_Cursor* p_cursor, size_t count);
+
+// Remove many elements in a single traversal. remove_range removes the
+// elements at indices [from, to); remove_if and remove_value return the
+// number of elements removed
+void CircularLinkedList_remove_range(struct CircularLinkedList* p_list, size_t from, size_t to);
+size_t CircularLinkedList_remove_if(struct CircularLinkedList* p_list, bool (*p_predicate)(int element, void* p_context), void* p_context);
+size_t CircularLinkedList_remove_value(struct CircularLinkedList* p_list, int element);
+
+// Serialize the list in the format used by CircularLinkedList_print. write
+// returns false on an I/O error; to_buffer behaves like snprintf: it writes at
+// most size - 1 characters plus a terminating NUL and returns the length of
+// the whole serialization
+bool CircularLinkedList_write(const struct CircularLinkedList* p_list, FILE* p_file);
+size_t CircularLinkedList_to_buffer(const struct CircularLinkedList* p_list, char* p_buffer, size_t size);
+
+// Binary snapshots: a 24-byte header ("CLLS", version, encoding, element count
+// and payload size, little endian) followed by the sorted elements, either as
+// raw int32 or as varint deltas, whichever is smaller. save returns false on
+// an I/O error; load returns NULL if the file cannot be read or is malformed.
+// Loaded lists store their nodes inline or in a single block, like clones
+bool CircularLinkedList_save(const struct CircularLinkedList* p_list, const char* p_path);
+struct CircularLinkedList* CircularLinkedList_load(const char* p_path);
+
+// Order-independent hash of the elements, equal for equal lists. Defining
+// CIRCULAR_LINKED_LIST_FINGERPRINT stores it in the list: every operation
+// keeps it up to date, it is read in O(1) and equals uses it to reject
+// different lists without walking them. Otherwise it is computed in O(n)
+uint64_t CircularLinkedList_fingerprint(const struct CircularLinkedList* p_list);
+#ifdef CIRCULAR_LINKED_LIST_FINGERPRINT
+// Recomputes the stored fingerprint of a list whose nodes were linked by other means
+uint64_t CircularLinkedList_rehash(struct CircularLinkedList* p_list);
+#endif
+
+// Relocates all the nodes into one contiguous block, in traversal order, so
+// that later traversals walk memory sequentially. Nodes in a block are
+// released one by one like any other, and the block is freed with its last
+// node. With set_auto_compact, insert and remove first compact the list once
+// the nodes their searches have visited reach ratio times the size plus the
+// nodes linked since the last compaction, which bounds the time compacting to
+// 1 / ratio of the time searching. insert_at_hint and remove_at_cursor do the
+// same after modifying the list, counting the nodes visited from the hint. A
+// ratio of 0 disables it. Read-only operations never compact. Compaction
+// invalidates cursors other than the one it is done through
+void CircularLinkedList_compact(struct CircularLinkedList* p_list);
+void CircularLinkedList_set_auto_compact(struct CircularLinkedList* p_list, size_t ratio);
+
+// Returns a copy of the list built in one pass. Its nodes are stored inline or
+// in a single block, like a compacted list, so the copy needs one allocation
+// for the list and at most one for all its nodes, and the same for freeing it
+struct CircularLinkedList* CircularLinkedList_clone(const struct CircularLinkedList* p_list);
+
+// Empty the list keeping its heap nodes for later insertions, which take them
+// before allocating new ones. clear takes O(1). reserve makes room for n
+// elements, allocating any missing nodes in a single block. The kept nodes
+// are only freed with the list
+void CircularLinkedList_clear(struct CircularLinkedList* p_list);
+void CircularLinkedList_reserve(struct CircularLinkedList* p_list, size_t n);
+
+#ifdef CIRCULAR_LINKED_LIST_STATS
+// Instrumentation of the traversals made by insert, remove and equals, enabled
+// by defining CIRCULAR_LINKED_LIST_STATS. A call visits as many nodes as links
+// it follows. Bucket 0 of a histogram counts calls visiting no nodes and
+// bucket b > 0 those visiting [2^(b-1), 2^b), the last bucket holding also
+// longer ones. Counters are global to all lists and not thread-safe
+#define CIRCULAR_LINKED_LIST_STATS_BUCKETS 32
+
+struct CircularLinkedList_OperationStats {
+  uint64_t calls;   // number of calls
+  uint64_t visited; // nodes visited by all the calls
+  uint64_t max;     // most nodes visited by a single call
+  uint64_t histogram[CIRCULAR_LINKED_LIST_STATS_BUCKETS]; // calls per number of nodes visited
+};
+
+struct CircularLinkedList_Stats {
+  struct CircularLinkedList_OperationStats insert;
+  struct CircularLinkedList_OperationStats remove;
+  struct CircularLinkedList_OperationStats equals;
+};
+
+const struct CircularLinkedList_Stats* CircularLinkedList_stats(void);
+void CircularLinkedList_reset_stats(void);
+// Writes the stats as a JSON object with one member per operation. Returns
+// false on an I/O error
+bool CircularLinkedList_write_stats_json(FILE* p_file);
+#endif
+
+// Defining CIRCULAR_LINKED_LIST_SELF_CHECK makes debug builds check, after
+// every operation that modifies lists, that they are circular, sorted and
+// consistent with p_last and size. Each check takes O(n) time and O(1) space
+
+#ifdef CIRCULAR_LINKED_LIST_TRACE
+// Records new, insert, remove, equals, print and free calls on p_file, one
+// line per call in the trace format replayed by the demo (see Demo.c), naming
+// each list by its address. Other operations are not recorded, so lists they
+// modify cannot be replayed faithfully. A NULL p_file stops recording
+void CircularLinkedList_set_trace(FILE* p_file);
+#endif
+
 #endif
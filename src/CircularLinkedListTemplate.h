@@ -0,0 +1,145 @@
+// Data Structures, University of Malaga
+//
+// Macro template for sorted circular linked lists of any element type. For a
+// list called Name holding elements of type T ordered by LESS, where LESS(a, b)
+// is a macro or inline function that is true when a goes before b:
+//
+//   DECLARE_CIRCULAR_LINKED_LIST(Name, T)          structs and prototypes (for headers)
+//   IMPLEMENT_CIRCULAR_LINKED_LIST(Name, T, LESS)  function definitions (in one .c file)
+//   DEFINE_CIRCULAR_LINKED_LIST(Name, T, LESS)     both of them
+//
+// generate struct Name, struct Name##_Node and Name_new, Name_insert,
+// Name_remove, Name_free and Name_equals, which behave like the
+// CircularLinkedList operations with the same name. LESS is expanded in place,
+// so comparisons are inlined rather than called through a pointer. Elements
+// are passed by value; two elements are equal if neither is LESS than the other.
+
+#ifndef CIRCULAR_LINKED_LIST_TEMPLATE_H
+#define CIRCULAR_LINKED_LIST_TEMPLATE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define DECLARE_CIRCULAR_LINKED_LIST(Name, T)                                                \
+  struct Name##_Node {                                                                      \
+    T element;                    /* element in the node */                                 \
+    struct Name##_Node* p_next;   /* pointer to the next node */                            \
+  };                                                                                        \
+                                                                                            \
+  struct Name {                                                                             \
+    struct Name##_Node* p_last;   /* pointer to the last node */                            \
+    size_t size;                  /* number of elements in the list */                      \
+  };                                                                                        \
+                                                                                            \
+  struct Name* Name##_new(void);                                                            \
+  void Name##_insert(struct Name* p_list, T element);                                       \
+  void Name##_remove(struct Name* p_list, size_t index);                                    \
+  void Name##_free(struct Name** p_p_list);                                                 \
+  bool Name##_equals(const struct Name* p_list1, const struct Name* p_list2);
+
+#define IMPLEMENT_CIRCULAR_LINKED_LIST(Name, T, LESS)                                        \
+  struct Name* Name##_new(void) {                                                           \
+    struct Name* p_list = malloc(sizeof(struct Name));                                      \
+    assert(p_list != NULL && "Memory allocation failed");                                  \
+                                                                                            \
+    p_list->p_last = NULL;                                                                  \
+    p_list->size = 0;                                                                       \
+    return p_list;                                                                          \
+  }                                                                                         \
+                                                                                            \
+  void Name##_insert(struct Name* p_list, T element) {                                      \
+    assert(p_list != NULL && "List is NULL");                                               \
+                                                                                            \
+    struct Name##_Node* p_node = malloc(sizeof(struct Name##_Node));                        \
+    assert(p_node != NULL && "Memory allocation failed");                                  \
+    p_node->element = element;                                                              \
+                                                                                            \
+    if (p_list->size == 0) {                                                                \
+      p_list->p_last = p_node;                                                              \
+      p_node->p_next = p_node;                                                              \
+    } else {                                                                                \
+      /* Find the first node whose element does not go before the new one */               \
+      struct Name##_Node* p_previous = p_list->p_last;                                      \
+      struct Name##_Node* p_current = p_previous->p_next;                                   \
+      size_t i = 0;                                                                         \
+      while (i < p_list->size && LESS(p_current->element, element)) {                       \
+        p_previous = p_current;                                                             \
+        p_current = p_current->p_next;                                                      \
+        i++;                                                                                \
+      }                                                                                     \
+                                                                                            \
+      p_previous->p_next = p_node;                                                          \
+      p_node->p_next = p_current;                                                           \
+      if (LESS(p_list->p_last->element, element)) {                                         \
+        p_list->p_last = p_node;                                                            \
+      }                                                                                     \
+    }                                                                                       \
+    p_list->size++;                                                                         \
+  }                                                                                         \
+                                                                                            \
+  void Name##_remove(struct Name* p_list, size_t index) {                                   \
+    assert(p_list != NULL && "List is NULL");                                               \
+    assert(index < p_list->size && "Index out of bounds");                                  \
+                                                                                            \
+    struct Name##_Node* p_previous = p_list->p_last;                                        \
+    struct Name##_Node* p_toDelete = p_previous->p_next;                                    \
+    for (size_t i = 0; i < index; i++) {                                                    \
+      p_previous = p_toDelete;                                                              \
+      p_toDelete = p_toDelete->p_next;                                                      \
+    }                                                                                       \
+                                                                                            \
+    p_previous->p_next = p_toDelete->p_next;                                                \
+    if (p_toDelete == p_list->p_last) {                                                     \
+      p_list->p_last = p_list->size == 1 ? NULL : p_previous;                               \
+    }                                                                                       \
+    free(p_toDelete);                                                                       \
+    p_list->size--;                                                                         \
+  }                                                                                         \
+                                                                                            \
+  void Name##_free(struct Name** p_p_list) {                                                \
+    assert(p_p_list != NULL && "Pointer is NULL");                                          \
+                                                                                            \
+    struct Name* p_list = *p_p_list;                                                        \
+    assert(p_list != NULL && "List is NULL");                                               \
+                                                                                            \
+    struct Name##_Node* p_current = p_list->p_last;                                         \
+    for (size_t i = 0; i < p_list->size; i++) {                                             \
+      struct Name##_Node* p_toDelete = p_current;                                           \
+      p_current = p_current->p_next;                                                        \
+      free(p_toDelete);                                                                     \
+    }                                                                                       \
+    free(p_list);                                                                           \
+    *p_p_list = NULL;                                                                       \
+  }                                                                                         \
+                                                                                            \
+  bool Name##_equals(const struct Name* p_list1, const struct Name* p_list2) {              \
+    assert(p_list1 != NULL && "List 1 is NULL");                                            \
+    assert(p_list2 != NULL && "List 2 is NULL");                                            \
+                                                                                            \
+    if (p_list1->size != p_list2->size) {                                                   \
+      return false;                                                                         \
+    }                                                                                       \
+    if (p_list1->size == 0) {                                                               \
+      return true;                                                                          \
+    }                                                                                       \
+                                                                                            \
+    const struct Name##_Node* p_current1 = p_list1->p_last->p_next;                         \
+    const struct Name##_Node* p_current2 = p_list2->p_last->p_next;                         \
+    for (size_t i = 0; i < p_list1->size; i++) {                                            \
+      if (LESS(p_current1->element, p_current2->element)                                    \
+          || LESS(p_current2->element, p_current1->element)) {                              \
+        return false;                                                                       \
+      }                                                                                     \
+      p_current1 = p_current1->p_next;                                                      \
+      p_current2 = p_current2->p_next;                                                      \
+    }                                                                                       \
+    return true;                                                                            \
+  }
+
+#define DEFINE_CIRCULAR_LINKED_LIST(Name, T, LESS)                                           \
+  DECLARE_CIRCULAR_LINKED_LIST(Name, T)                                                      \
+  IMPLEMENT_CIRCULAR_LINKED_LIST(Name, T, LESS)
+
+#endif
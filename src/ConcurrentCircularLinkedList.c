@@ -0,0 +1,136 @@
+// Data Structures, University of Malaga
+//
+// Allocations in this file are not instrumented by the unit test framework,
+// whose memory tracker is not thread-safe.
+
+#include <stdlib.h>
+#include <assert.h>
+
+#include "ConcurrentCircularLinkedList.h"
+
+struct ConcurrentCircularLinkedList* ConcurrentCircularLinkedList_new() {
+  // Allocate memory for the list
+  struct ConcurrentCircularLinkedList* p_list = malloc(sizeof(struct ConcurrentCircularLinkedList));
+  assert(p_list != NULL && "Memory allocation failed");
+
+  // Initialize the list. The sentinel follows itself while the list is empty
+  p_list->sentinel.p_next = &p_list->sentinel;
+  pthread_mutex_init(&p_list->sentinel.mutex, NULL);
+  atomic_init(&p_list->size, 0);
+  return p_list;
+}
+
+// Locks the last node whose element is smaller than element (or the sentinel)
+// and its successor, unless the successor is the sentinel. Locks are taken in
+// list order starting from the sentinel, and never on the sentinel at the end,
+// so threads cannot deadlock. Returns the locked predecessor and stores its
+// successor in *p_p_current
+static struct ConcurrentNode* ConcurrentCircularLinkedList_find(struct ConcurrentCircularLinkedList* p_list, int element, struct ConcurrentNode** p_p_current) {
+  struct ConcurrentNode* p_sentinel = &p_list->sentinel;
+  struct ConcurrentNode* p_previous = p_sentinel;
+  pthread_mutex_lock(&p_previous->mutex);
+
+  struct ConcurrentNode* p_current = p_previous->p_next;
+  while (p_current != p_sentinel) {
+    pthread_mutex_lock(&p_current->mutex);
+    if (p_current->element >= element) {
+      break;
+    }
+    pthread_mutex_unlock(&p_previous->mutex);
+    p_previous = p_current;
+    p_current = p_current->p_next;
+  }
+
+  *p_p_current = p_current;
+  return p_previous;
+}
+
+static void ConcurrentCircularLinkedList_unlock(struct ConcurrentCircularLinkedList* p_list, struct ConcurrentNode* p_previous, struct ConcurrentNode* p_current) {
+  if (p_current != &p_list->sentinel) {
+    pthread_mutex_unlock(&p_current->mutex);
+  }
+  pthread_mutex_unlock(&p_previous->mutex);
+}
+
+void ConcurrentCircularLinkedList_insert(struct ConcurrentCircularLinkedList* p_list, int element) {
+  assert(p_list != NULL && "List is NULL");
+
+  // Allocate the node before taking any lock
+  struct ConcurrentNode* p_node = malloc(sizeof(struct ConcurrentNode));
+  assert(p_node != NULL && "Memory allocation failed");
+  p_node->element = element;
+  pthread_mutex_init(&p_node->mutex, NULL);
+
+  struct ConcurrentNode* p_current;
+  struct ConcurrentNode* p_previous = ConcurrentCircularLinkedList_find(p_list, element, &p_current);
+
+  // Insert the new element between p_previous and p_current. Other threads
+  // cannot reach it before p_previous is unlocked, after size is updated
+  p_node->p_next = p_current;
+  p_previous->p_next = p_node;
+  atomic_fetch_add(&p_list->size, 1);
+
+  ConcurrentCircularLinkedList_unlock(p_list, p_previous, p_current);
+}
+
+bool ConcurrentCircularLinkedList_remove_value(struct ConcurrentCircularLinkedList* p_list, int element) {
+  assert(p_list != NULL && "List is NULL");
+
+  struct ConcurrentNode* p_current;
+  struct ConcurrentNode* p_previous = ConcurrentCircularLinkedList_find(p_list, element, &p_current);
+
+  if (p_current == &p_list->sentinel || p_current->element != element) {
+    ConcurrentCircularLinkedList_unlock(p_list, p_previous, p_current);
+    return false;
+  }
+
+  // Unlink the node. Any other thread heading for it would first need the
+  // lock of p_previous, so once unlocked nobody can reach it and it can be freed
+  p_previous->p_next = p_current->p_next;
+  atomic_fetch_sub(&p_list->size, 1);
+  pthread_mutex_unlock(&p_current->mutex);
+  pthread_mutex_unlock(&p_previous->mutex);
+
+  pthread_mutex_destroy(&p_current->mutex);
+  free(p_current);
+  return true;
+}
+
+bool ConcurrentCircularLinkedList_contains(struct ConcurrentCircularLinkedList* p_list, int element) {
+  assert(p_list != NULL && "List is NULL");
+
+  struct ConcurrentNode* p_current;
+  struct ConcurrentNode* p_previous = ConcurrentCircularLinkedList_find(p_list, element, &p_current);
+  bool found = p_current != &p_list->sentinel && p_current->element == element;
+  ConcurrentCircularLinkedList_unlock(p_list, p_previous, p_current);
+  return found;
+}
+
+size_t ConcurrentCircularLinkedList_size(const struct ConcurrentCircularLinkedList* p_list) {
+  assert(p_list != NULL && "List is NULL");
+
+  return atomic_load(&p_list->size);
+}
+
+void ConcurrentCircularLinkedList_free(struct ConcurrentCircularLinkedList** p_p_list) {
+  assert(p_p_list != NULL && "Pointer is NULL");
+
+  struct ConcurrentCircularLinkedList* p_list = *p_p_list;
+  assert(p_list != NULL && "List is NULL");
+
+  // Free all the nodes in the list
+  struct ConcurrentNode* p_current = p_list->sentinel.p_next;
+  while (p_current != &p_list->sentinel) {
+    struct ConcurrentNode* p_toDelete = p_current;
+    p_current = p_current->p_next;
+    pthread_mutex_destroy(&p_toDelete->mutex);
+    free(p_toDelete);
+  }
+
+  // Free the list structure
+  pthread_mutex_destroy(&p_list->sentinel.mutex);
+  free(p_list);
+
+  // Set the pointer to the list to NULL
+  *p_p_list = NULL;
+}
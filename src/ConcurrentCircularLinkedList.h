@@ -0,0 +1,37 @@
+// Data Structures, University of Malaga
+//
+// Sorted circular linked list that can be shared by several threads. Nodes
+// are locked hand over hand from a sentinel head, so operations on disjoint
+// parts of the list proceed in parallel and a node can only be freed by the
+// thread that unlinks it. insert, remove_value, contains and size may be
+// called concurrently; new and free may not.
+
+#ifndef CONCURRENT_CIRCULAR_LINKED_LIST_H
+#define CONCURRENT_CIRCULAR_LINKED_LIST_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+struct ConcurrentNode {
+  int element;                   // element in the node (unused in the sentinel)
+  struct ConcurrentNode* p_next; // pointer to the next node (the sentinel after the last one)
+  pthread_mutex_t mutex;         // protects p_next
+};
+
+struct ConcurrentCircularLinkedList {
+  struct ConcurrentNode sentinel; // precedes the first node and follows the last one
+  atomic_size_t size;             // number of elements in the list
+};
+
+struct ConcurrentCircularLinkedList* ConcurrentCircularLinkedList_new();
+void ConcurrentCircularLinkedList_insert(struct ConcurrentCircularLinkedList* p_list, int element);
+// Removes one occurrence of element. Returns false if there was none
+bool ConcurrentCircularLinkedList_remove_value(struct ConcurrentCircularLinkedList* p_list, int element);
+bool ConcurrentCircularLinkedList_contains(struct ConcurrentCircularLinkedList* p_list, int element);
+// Linearizable: it changes while the locks of the modified nodes are held
+size_t ConcurrentCircularLinkedList_size(const struct ConcurrentCircularLinkedList* p_list);
+void ConcurrentCircularLinkedList_free(struct ConcurrentCircularLinkedList** p_p_list);
+
+#endif
@@ -1,48 +1,323 @@
 // Pepe Gallardo, Data Structures, University of Malaga
+//
+// Replays a trace of list operations and reports throughput and latency
+// percentiles per operation. The trace is read from the file given as first
+// argument, or from standard input, one operation per line:
+//
+//   n <list>          create a list
+//   i <list> <value>  insert value
+//   r <list> <index>  remove the element at index
+//   e <list> <list>   compare two lists
+//   p <list>          print a list
+//   f <list>          free a list
+//
+// Lists are named by arbitrary unsigned decimal integers, as recorded by
+// CircularLinkedList_set_trace. Empty lines and lines starting with # are
+// ignored, and lines longer than 255 characters are rejected. The trace is
+// streamed, never held in memory. Output of p goes to standard output and the report to standard
+// error, so that the output of different backends can be compared.
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
 
-#include "CircularLinkedList.h"
+#include "ListBackend.h"
 
-int runDemo(void) {
-  struct CircularLinkedList* p_list1 = CircularLinkedList_new();
+/*============================================================================*/
+/* Lists named in the trace, in an open addressing hash table                 */
+/*============================================================================*/
+struct Slot {
+  unsigned long long name; // name of the list in the trace
+  struct List* p_list;     // NULL for empty slots
+  size_t size;             // number of elements, to validate removals
+  int removed;             // slot of a freed list, skipped by lookups
+};
 
-  CircularLinkedList_insert(p_list1, 3);
-  CircularLinkedList_insert(p_list1, 1);
-  CircularLinkedList_insert(p_list1, 5);
-  CircularLinkedList_insert(p_list1, 2);
-  CircularLinkedList_insert(p_list1, 4);
-  CircularLinkedList_insert(p_list1, 6);
+struct Lists {
+  struct Slot* p_slots;
+  size_t capacity; // power of two
+  size_t used;     // slots holding a list or removed
+};
 
-  printf("List1 after inserting elements: ");
-  CircularLinkedList_print(p_list1); // 1 2 3 4 5 6
+static size_t Lists_hash(unsigned long long name, size_t capacity) {
+  return (size_t) ((name * 0x9E3779B97F4A7C15ULL) >> 32) & (capacity - 1);
+}
 
-  CircularLinkedList_remove(p_list1, 5);
-  CircularLinkedList_remove(p_list1, 1);
-  CircularLinkedList_remove(p_list1, 0);
+// Slot of the list named name, or the empty slot where it would go
+static struct Slot* Lists_find(struct Lists* p_lists, unsigned long long name) {
+  size_t i = Lists_hash(name, p_lists->capacity);
+  while (p_lists->p_slots[i].p_list != NULL || p_lists->p_slots[i].removed) {
+    if (p_lists->p_slots[i].p_list != NULL && p_lists->p_slots[i].name == name) {
+      break;
+    }
+    i = (i + 1) & (p_lists->capacity - 1);
+  }
+  return &p_lists->p_slots[i];
+}
 
-  printf("List1 after removing elements: ");
-  CircularLinkedList_print(p_list1); // 3 4 5
+static void Lists_grow(struct Lists* p_lists) {
+  struct Slot* p_old = p_lists->p_slots;
+  size_t capacity = p_lists->capacity;
 
-  struct CircularLinkedList* p_list2 = CircularLinkedList_new();
+  p_lists->capacity = capacity == 0 ? 16 : 2 * capacity;
+  p_lists->p_slots = calloc(p_lists->capacity, sizeof(struct Slot));
+  if (p_lists->p_slots == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(EXIT_FAILURE);
+  }
+  p_lists->used = 0;
+  for (size_t i = 0; i < capacity; i++) {
+    if (p_old[i].p_list != NULL) {
+      *Lists_find(p_lists, p_old[i].name) = p_old[i];
+      p_lists->used++;
+    }
+  }
+  free(p_old);
+}
+
+// Slot for a new list named name (the caller sets its list)
+static struct Slot* Lists_add(struct Lists* p_lists, unsigned long long name) {
+  if (2 * (p_lists->used + 1) > p_lists->capacity) {
+    Lists_grow(p_lists);
+  }
+  struct Slot* p_slot = Lists_find(p_lists, name);
+  p_slot->name = name;
+  p_slot->size = 0;
+  p_slot->removed = 0;
+  p_lists->used++;
+  return p_slot;
+}
 
-  CircularLinkedList_insert(p_list2, 5);
-  CircularLinkedList_insert(p_list2, 4);
-  CircularLinkedList_insert(p_list2, 3);
+/*============================================================================*/
+/* Latencies, in a histogram with a relative error below 1/16                 */
+/*============================================================================*/
+#define SUB_BUCKETS 16
+#define BUCKETS (61 * SUB_BUCKETS)
 
-  printf("List2 after inserting elements: ");
-  CircularLinkedList_print(p_list2); // 3 4 5
+struct Latencies {
+  const char* name;
+  unsigned long long count;
+  double total; // seconds
+  unsigned long long max; // nanoseconds
+  unsigned long long buckets[BUCKETS];
+};
 
-  if(CircularLinkedList_equals(p_list1, p_list2)) {
-    printf("Lists are equal\n");
-  } else {
-    printf("Lists are not equal\n");
+// Values below 16 get a bucket each. Larger ones are split by their highest
+// bit and the 4 bits that follow it
+static size_t Latencies_bucket(unsigned long long nanoseconds) {
+  if (nanoseconds < SUB_BUCKETS) {
+    return (size_t) nanoseconds;
   }
+  int exponent = 0;
+  while (nanoseconds >> (exponent + 1) != 0) {
+    exponent++;
+  }
+  return (size_t) (exponent - 3) * SUB_BUCKETS + (size_t) ((nanoseconds >> (exponent - 4)) & (SUB_BUCKETS - 1));
+}
+
+// Smallest value falling into bucket
+static unsigned long long Latencies_value(size_t bucket) {
+  if (bucket < SUB_BUCKETS) {
+    return bucket;
+  }
+  int exponent = (int) (bucket / SUB_BUCKETS) + 3;
+  return (unsigned long long) (SUB_BUCKETS + bucket % SUB_BUCKETS) << (exponent - 4);
+}
 
-  CircularLinkedList_free(&p_list1);
-  CircularLinkedList_free(&p_list2);
+static void Latencies_record(struct Latencies* p_latencies, double seconds) {
+  unsigned long long nanoseconds = seconds <= 0 ? 0 : (unsigned long long) (seconds * 1e9);
+  p_latencies->count++;
+  p_latencies->total += seconds;
+  if (nanoseconds > p_latencies->max) {
+    p_latencies->max = nanoseconds;
+  }
+  p_latencies->buckets[Latencies_bucket(nanoseconds)]++;
+}
 
-  printf("Lists have been freed\n");
-  
-  return 0;
-}
\ No newline at end of file
+static unsigned long long Latencies_percentile(const struct Latencies* p_latencies, double percentile) {
+  unsigned long long rank = (unsigned long long) (percentile / 100 * (double) p_latencies->count);
+  unsigned long long seen = 0;
+  for (size_t i = 0; i < BUCKETS; i++) {
+    seen += p_latencies->buckets[i];
+    if (seen > rank) {
+      return Latencies_value(i);
+    }
+  }
+  return p_latencies->max;
+}
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+/*============================================================================*/
+/* Trace replay                                                               */
+/*============================================================================*/
+
+// Parses the next unsigned decimal integer in *p_p_text, advancing past it
+static int parseNumber(char** p_p_text, unsigned long long* p_value) {
+  char* p_end;
+  while (isspace((unsigned char) **p_p_text)) {
+    (*p_p_text)++;
+  }
+  if (!isdigit((unsigned char) **p_p_text)) {
+    return 0;
+  }
+  *p_value = strtoull(*p_p_text, &p_end, 10);
+  *p_p_text = p_end;
+  return 1;
+}
+
+static int parseInt(char** p_p_text, int* p_value) {
+  char* p_end;
+  long value = strtol(*p_p_text, &p_end, 10);
+  if (p_end == *p_p_text || value < INT32_MIN || value > INT32_MAX) {
+    return 0;
+  }
+  *p_value = (int) value;
+  *p_p_text = p_end;
+  return 1;
+}
+
+int runDemo(int argc, char* argv[]) {
+  FILE* p_trace = stdin;
+  if (argc > 1) {
+    p_trace = fopen(argv[1], "r");
+    if (p_trace == NULL) {
+      fprintf(stderr, "Cannot open trace %s\n", argv[1]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  static struct Latencies latencies[] = {
+    { .name = "new" }, { .name = "insert" }, { .name = "remove" },
+    { .name = "equals" }, { .name = "print" }, { .name = "free" },
+  };
+  enum { NEW, INSERT, REMOVE, EQUALS, PRINT, FREE };
+
+  struct Lists lists = { NULL, 0, 0 };
+  Lists_grow(&lists);
+
+  int status = EXIT_SUCCESS;
+  unsigned long long line = 0;
+  char buffer[256];
+  double start = now_seconds();
+
+  while (fgets(buffer, sizeof(buffer), p_trace) != NULL) {
+    line++;
+    if (strchr(buffer, '\n') == NULL && !feof(p_trace)) {
+      fprintf(stderr, "Line %llu is longer than %zu characters\n", line, sizeof(buffer) - 1);
+      status = EXIT_FAILURE;
+      break;
+    }
+    char* p_text = buffer;
+    while (isspace((unsigned char) *p_text)) {
+      p_text++;
+    }
+    if (*p_text == '\0' || *p_text == '#') {
+      continue;
+    }
+
+    char operation = *p_text++;
+    unsigned long long name1, name2;
+    int argument = 0;
+    struct Slot* p_slot1 = NULL;
+    struct Slot* p_slot2 = NULL;
+    int valid = parseNumber(&p_text, &name1);
+    if (valid && operation != 'n') {
+      p_slot1 = Lists_find(&lists, name1);
+      valid = p_slot1->p_list != NULL;
+    }
+    if (valid && (operation == 'i' || operation == 'r')) {
+      valid = parseInt(&p_text, &argument) && (operation == 'i' || (argument >= 0 && (size_t) argument < p_slot1->size));
+    } else if (valid && operation == 'e') {
+      valid = parseNumber(&p_text, &name2) && (p_slot2 = Lists_find(&lists, name2))->p_list != NULL;
+    } else if (valid && operation == 'n') {
+      valid = Lists_find(&lists, name1)->p_list == NULL;
+    }
+    if (!valid || strchr("nirepf", operation) == NULL) {
+      fprintf(stderr, "Invalid operation at line %llu: %s", line, buffer);
+      status = EXIT_FAILURE;
+      break;
+    }
+
+    // Only the operation itself is timed
+    double before;
+    switch (operation) {
+      case 'n': {
+        struct Slot* p_slot = Lists_add(&lists, name1);
+        before = now_seconds();
+        p_slot->p_list = List_new();
+        Latencies_record(&latencies[NEW], now_seconds() - before);
+        break;
+      }
+      case 'i':
+        before = now_seconds();
+        List_insert(p_slot1->p_list, argument);
+        Latencies_record(&latencies[INSERT], now_seconds() - before);
+        p_slot1->size++;
+        break;
+      case 'r':
+        before = now_seconds();
+        List_remove(p_slot1->p_list, (size_t) argument);
+        Latencies_record(&latencies[REMOVE], now_seconds() - before);
+        p_slot1->size--;
+        break;
+      case 'e': {
+        before = now_seconds();
+        bool equal = List_equals(p_slot1->p_list, p_slot2->p_list);
+        Latencies_record(&latencies[EQUALS], now_seconds() - before);
+        printf("%s\n", equal ? "equal" : "not equal");
+        break;
+      }
+      case 'p':
+        before = now_seconds();
+        List_print(p_slot1->p_list);
+        Latencies_record(&latencies[PRINT], now_seconds() - before);
+        break;
+      case 'f':
+        before = now_seconds();
+        List_free(&p_slot1->p_list);
+        Latencies_record(&latencies[FREE], now_seconds() - before);
+        p_slot1->removed = 1;
+        break;
+    }
+  }
+  double elapsed = now_seconds() - start;
+
+  if (p_trace != stdin) {
+    fclose(p_trace);
+  }
+
+  // Free the lists the trace left alive
+  for (size_t i = 0; i < lists.capacity; i++) {
+    if (lists.p_slots[i].p_list != NULL) {
+      List_free(&lists.p_slots[i].p_list);
+    }
+  }
+  free(lists.p_slots);
+
+  unsigned long long operations = 0;
+  for (size_t k = 0; k < sizeof(latencies) / sizeof(latencies[0]); k++) {
+    operations += latencies[k].count;
+  }
+  fprintf(stderr, "Using %s\n", LIST_BACKEND_NAME);
+  fprintf(stderr, "%llu operations in %.6f s (%.0f operations/s, including parsing)\n", operations, elapsed, elapsed > 0 ? (double) operations / elapsed : 0.0);
+  fprintf(stderr, "%-8s %12s %12s %10s %10s %10s %10s %10s\n", "op", "count", "ops/s", "p50(ns)", "p90(ns)", "p99(ns)", "p99.9(ns)", "max(ns)");
+  for (size_t k = 0; k < sizeof(latencies) / sizeof(latencies[0]); k++) {
+    const struct Latencies* p_latencies = &latencies[k];
+    if (p_latencies->count == 0) {
+      continue;
+    }
+    fprintf(stderr, "%-8s %12llu %12.0f %10llu %10llu %10llu %10llu %10llu\n", p_latencies->name, p_latencies->count,
+            p_latencies->total > 0 ? (double) p_latencies->count / p_latencies->total : 0.0,
+            Latencies_percentile(p_latencies, 50), Latencies_percentile(p_latencies, 90),
+            Latencies_percentile(p_latencies, 99), Latencies_percentile(p_latencies, 99.9), p_latencies->max);
+  }
+  return status;
+}
@@ -0,0 +1,80 @@
+// Data Structures, University of Malaga
+//
+// Build-time selection of the sorted list implementation used by programs
+// that are not tied to a particular one (e.g. the demo). Define one of
+//
+//   LIST_BACKEND_CircularLinkedList (default)
+//   LIST_BACKEND_UnrolledCircularLinkedList
+//   LIST_BACKEND_SortedRingBuffer
+//   LIST_BACKEND_RunLengthCircularLinkedList
+//   LIST_BACKEND_ArenaCircularLinkedList
+//
+// (CMake does it from the LIST_BACKEND cache variable) and use struct List and
+// the List_* operations, which map to the chosen implementation.
+
+#ifndef LIST_BACKEND_H
+#define LIST_BACKEND_H
+
+#if defined(LIST_BACKEND_UnrolledCircularLinkedList)
+
+#include "UnrolledCircularLinkedList.h"
+#define LIST_BACKEND_NAME "UnrolledCircularLinkedList"
+#define List UnrolledCircularLinkedList
+#define List_new UnrolledCircularLinkedList_new
+#define List_insert UnrolledCircularLinkedList_insert
+#define List_remove UnrolledCircularLinkedList_remove
+#define List_print UnrolledCircularLinkedList_print
+#define List_free UnrolledCircularLinkedList_free
+#define List_equals UnrolledCircularLinkedList_equals
+
+#elif defined(LIST_BACKEND_SortedRingBuffer)
+
+#include "SortedRingBuffer.h"
+#define LIST_BACKEND_NAME "SortedRingBuffer"
+#define List SortedRingBuffer
+#define List_new SortedRingBuffer_new
+#define List_insert SortedRingBuffer_insert
+#define List_remove SortedRingBuffer_remove
+#define List_print SortedRingBuffer_print
+#define List_free SortedRingBuffer_free
+#define List_equals SortedRingBuffer_equals
+
+#elif defined(LIST_BACKEND_RunLengthCircularLinkedList)
+
+#include "RunLengthCircularLinkedList.h"
+#define LIST_BACKEND_NAME "RunLengthCircularLinkedList"
+#define List RunLengthCircularLinkedList
+#define List_new RunLengthCircularLinkedList_new
+#define List_insert RunLengthCircularLinkedList_insert
+#define List_remove RunLengthCircularLinkedList_remove
+#define List_print RunLengthCircularLinkedList_print
+#define List_free RunLengthCircularLinkedList_free
+#define List_equals RunLengthCircularLinkedList_equals
+
+#elif defined(LIST_BACKEND_ArenaCircularLinkedList)
+
+#include "ArenaCircularLinkedList.h"
+#define LIST_BACKEND_NAME "ArenaCircularLinkedList"
+#define List ArenaCircularLinkedList
+#define List_new ArenaCircularLinkedList_new
+#define List_insert ArenaCircularLinkedList_insert
+#define List_remove ArenaCircularLinkedList_remove
+#define List_print ArenaCircularLinkedList_print
+#define List_free ArenaCircularLinkedList_free
+#define List_equals ArenaCircularLinkedList_equals
+
+#else
+
+#include "CircularLinkedList.h"
+#define LIST_BACKEND_NAME "CircularLinkedList"
+#define List CircularLinkedList
+#define List_new CircularLinkedList_new
+#define List_insert CircularLinkedList_insert
+#define List_remove CircularLinkedList_remove
+#define List_print CircularLinkedList_print
+#define List_free CircularLinkedList_free
+#define List_equals CircularLinkedList_equals
+
+#endif
+
+#endif
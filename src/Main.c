@@ -4,9 +4,10 @@
 
 /*============================================================================*/
 /* Execution modes:                                                           */
-/* Define either RUN_TESTS or RUN_DEMO to run the corresponding functionality.*/
-/* Notice that only one mode can be defined (#define) at a time and the other */
-/* must be undefined (#undef)                                                 */
+/* Define one of RUN_TESTS or RUN_DEMO to run the corresponding               */
+/* functionality. The benchmark is a separate executable (see src/bench).     */
+/* Notice that only one mode can be defined (#define) at a time and the       */
+/* others must be undefined (#undef)                                          */
 /*============================================================================*/
 
 #define RUN_TESTS
@@ -19,7 +20,7 @@
 #endif
 
 int runAllTests(int argc, char* argv[]);
-int runDemo(void);
+int runDemo(int argc, char* argv[]);
 
 int main(int argc, char* argv[]) {
     #if defined(RUN_TESTS) && defined(RUN_DEMO)
@@ -29,7 +30,7 @@ int main(int argc, char* argv[]) {
     #elif defined(RUN_TESTS)
     return runAllTests(argc, argv);
     #elif defined(RUN_DEMO)
-    return runDemo();
+    return runDemo(argc, argv);
     #endif
 }
 
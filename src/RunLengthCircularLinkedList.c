@@ -0,0 +1,179 @@
+// Data Structures, University of Malaga
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "RunLengthCircularLinkedList.h"
+#include "test/unit/UnitTest.h"
+
+struct RunLengthCircularLinkedList* RunLengthCircularLinkedList_new() {
+  // Allocate memory for the list
+  struct RunLengthCircularLinkedList* p_list = malloc(sizeof(struct RunLengthCircularLinkedList));
+  assert(p_list != NULL && "Memory allocation failed");
+
+  // Initialize the list
+  p_list->p_last = NULL;
+  p_list->size = 0;
+  p_list->runs = 0;
+  return p_list;
+}
+
+void RunLengthCircularLinkedList_insert(struct RunLengthCircularLinkedList* p_list, int element) {
+  assert(p_list != NULL && "List is NULL");
+
+  struct RunNode* p_previous = p_list->p_last; // Last node
+  struct RunNode* p_current = NULL;
+
+  if (p_list->runs != 0) {
+    if (element > p_list->p_last->element) {
+      // Goes after the last node: no need to walk the list
+      p_current = p_previous->p_next;
+    } else {
+      // Find the first node whose element is not smaller than element. The
+      // last node stops the search
+      p_current = p_previous->p_next;
+      while (p_current->element < element) {
+        p_previous = p_current;
+        p_current = p_current->p_next;
+      }
+
+      if (p_current->element == element) {
+        // A repetition only increments the count of its node
+        assert(p_current->count < UINT_MAX && "Count overflow");
+        p_current->count++;
+        p_list->size++;
+        return;
+      }
+    }
+  }
+
+  // Allocate memory for a new node holding one occurrence of element
+  struct RunNode* p_node = malloc(sizeof(struct RunNode));
+  assert(p_node != NULL && "Memory allocation failed");
+  p_node->element = element;
+  p_node->count = 1;
+
+  if (p_list->runs == 0) {
+    // The list is empty
+    p_node->p_next = p_node;
+    p_list->p_last = p_node;
+  } else {
+    // Insert the new node between p_previous and p_current
+    p_previous->p_next = p_node;
+    p_node->p_next = p_current;
+    if (element > p_list->p_last->element) {
+      p_list->p_last = p_node;
+    }
+  }
+  p_list->runs++;
+  p_list->size++;
+}
+
+void RunLengthCircularLinkedList_remove(struct RunLengthCircularLinkedList* p_list, size_t index) {
+  assert(p_list != NULL && "List is NULL");
+  assert(index < p_list->size && "Index out of bounds");
+
+  struct RunNode* p_previous = p_list->p_last;   // Last node
+  struct RunNode* p_current = p_previous->p_next; // First node
+
+  // Find the node holding the element by skipping whole runs
+  while (index >= p_current->count) {
+    index -= p_current->count;
+    p_previous = p_current;
+    p_current = p_current->p_next;
+  }
+
+  p_list->size--;
+  if (--p_current->count != 0) {
+    return;
+  }
+
+  // That was the last occurrence: unlink and free the node
+  p_previous->p_next = p_current->p_next;
+  if (p_current == p_list->p_last) {
+    p_list->p_last = p_list->runs == 1 ? NULL : p_previous;
+  }
+  free(p_current);
+  p_list->runs--;
+}
+
+void RunLengthCircularLinkedList_print(const struct RunLengthCircularLinkedList* p_list) {
+  assert(p_list != NULL && "List is NULL");
+
+  if (p_list->runs != 0) {
+    const struct RunNode* p_current = p_list->p_last->p_next;
+    for (size_t i = 0; i < p_list->runs; i++) {
+      for (unsigned j = 0; j < p_current->count; j++) {
+        printf("%d ", p_current->element);
+      }
+      p_current = p_current->p_next;
+    }
+  }
+  printf("\n");
+}
+
+void RunLengthCircularLinkedList_free(struct RunLengthCircularLinkedList** p_p_list) {
+  assert(p_p_list != NULL && "Pointer is NULL");
+
+  struct RunLengthCircularLinkedList* p_list = *p_p_list;
+  assert(p_list != NULL && "List is NULL");
+
+  // Free all the nodes in the list
+  struct RunNode* p_current = p_list->p_last;
+  for (size_t i = 0; i < p_list->runs; i++) {
+    struct RunNode* p_toDelete = p_current;
+    p_current = p_current->p_next;
+    free(p_toDelete);
+  }
+
+  // Free the list structure
+  free(p_list);
+
+  // Set the pointer to the list to NULL
+  *p_p_list = NULL;
+}
+
+bool RunLengthCircularLinkedList_equals(const struct RunLengthCircularLinkedList* p_list1, const struct RunLengthCircularLinkedList* p_list2) {
+  assert(p_list1 != NULL && "List 1 is NULL");
+  assert(p_list2 != NULL && "List 2 is NULL");
+
+  // Each distinct element has exactly one node, so equal lists have the same runs
+  if (p_list1->size != p_list2->size || p_list1->runs != p_list2->runs) {
+    return false;
+  }
+
+  if (p_list1->runs == 0) {
+    return true;
+  }
+
+  const struct RunNode* p_current1 = p_list1->p_last->p_next;
+  const struct RunNode* p_current2 = p_list2->p_last->p_next;
+
+  for (size_t i = 0; i < p_list1->runs; i++) {
+    if (p_current1->element != p_current2->element || p_current1->count != p_current2->count) {
+      return false;
+    }
+    p_current1 = p_current1->p_next;
+    p_current2 = p_current2->p_next;
+  }
+
+  return true;
+}
+
+size_t RunLengthCircularLinkedList_count(const struct RunLengthCircularLinkedList* p_list, int element) {
+  assert(p_list != NULL && "List is NULL");
+
+  // Reject elements outside the range of the list without walking it
+  if (p_list->runs == 0 || element < p_list->p_last->p_next->element || element > p_list->p_last->element) {
+    return 0;
+  }
+
+  // The last node stops the search
+  const struct RunNode* p_current = p_list->p_last->p_next;
+  while (p_current->element < element) {
+    p_current = p_current->p_next;
+  }
+  return p_current->element == element ? p_current->count : 0;
+}
@@ -0,0 +1,35 @@
+// Data Structures, University of Malaga
+//
+// Sorted circular linked list for multisets with many repeated elements.
+// Each node stores a distinct element together with the number of times it
+// occurs, so duplicates cost neither memory nor traversal steps. Indices
+// refer to elements, as in CircularLinkedList, not to nodes.
+
+#ifndef RUN_LENGTH_CIRCULAR_LINKED_LIST_H
+#define RUN_LENGTH_CIRCULAR_LINKED_LIST_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+struct RunNode {
+  int element;            // element in the node
+  unsigned count;         // number of occurrences of element (> 0)
+  struct RunNode* p_next; // pointer to the next node
+};
+
+struct RunLengthCircularLinkedList {
+  struct RunNode* p_last; // pointer to the last node
+  size_t size;            // number of elements in the list, counting repetitions
+  size_t runs;            // number of nodes (distinct elements) in the list
+};
+
+struct RunLengthCircularLinkedList* RunLengthCircularLinkedList_new();
+void RunLengthCircularLinkedList_insert(struct RunLengthCircularLinkedList* p_list, int element);
+void RunLengthCircularLinkedList_remove(struct RunLengthCircularLinkedList* p_list, size_t index);
+void RunLengthCircularLinkedList_print(const struct RunLengthCircularLinkedList* p_list);
+void RunLengthCircularLinkedList_free(struct RunLengthCircularLinkedList** p_p_list);
+bool RunLengthCircularLinkedList_equals(const struct RunLengthCircularLinkedList* p_list1, const struct RunLengthCircularLinkedList* p_list2);
+// Number of occurrences of element
+size_t RunLengthCircularLinkedList_count(const struct RunLengthCircularLinkedList* p_list, int element);
+
+#endif
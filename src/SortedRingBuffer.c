@@ -0,0 +1,188 @@
+// Data Structures, University of Malaga
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "SortedRingBuffer.h"
+#include "test/unit/UnitTest.h"
+
+#define INITIAL_CAPACITY 8
+
+// Slot holding the element at a logical index. Capacity is a power of two,
+// so wrapping around is a mask (this also works for index -1)
+static inline size_t SortedRingBuffer_slot(const struct SortedRingBuffer* p_buffer, size_t index) {
+  return (p_buffer->head + index) & (p_buffer->capacity - 1);
+}
+
+// Index of the first element not smaller than element. Branchless: the loop
+// runs exactly log2(size) times and the comparison compiles to a cmov
+static size_t SortedRingBuffer_lowerBound(const struct SortedRingBuffer* p_buffer, int element) {
+  if (p_buffer->size == 0) {
+    return 0;
+  }
+
+  size_t base = 0;
+  size_t length = p_buffer->size;
+  while (length > 1) {
+    size_t half = length / 2;
+    base = p_buffer->p_elements[SortedRingBuffer_slot(p_buffer, base + half)] < element ? base + half : base;
+    length -= half;
+  }
+  return base + (p_buffer->p_elements[SortedRingBuffer_slot(p_buffer, base)] < element);
+}
+
+// Moves elements at logical indices [first, first + count) one slot up.
+// Contiguous runs are moved with memmove, starting from the end
+static void SortedRingBuffer_shiftUp(struct SortedRingBuffer* p_buffer, size_t first, size_t count) {
+  int* p_elements = p_buffer->p_elements;
+  size_t remaining = count;
+  while (remaining > 0) {
+    size_t source = SortedRingBuffer_slot(p_buffer, first + remaining - 1);
+    if (source == p_buffer->capacity - 1) {
+      // Crossing the end of the storage
+      p_elements[0] = p_elements[source];
+      remaining--;
+    } else {
+      size_t run = remaining < source + 1 ? remaining : source + 1;
+      memmove(p_elements + source - run + 2, p_elements + source - run + 1, run * sizeof(int));
+      remaining -= run;
+    }
+  }
+}
+
+// Moves elements at logical indices [first, first + count) one slot down.
+// Contiguous runs are moved with memmove, starting from the beginning
+static void SortedRingBuffer_shiftDown(struct SortedRingBuffer* p_buffer, size_t first, size_t count) {
+  int* p_elements = p_buffer->p_elements;
+  size_t moved = 0;
+  while (moved < count) {
+    size_t source = SortedRingBuffer_slot(p_buffer, first + moved);
+    if (source == 0) {
+      // Crossing the beginning of the storage
+      p_elements[p_buffer->capacity - 1] = p_elements[0];
+      moved++;
+    } else {
+      size_t run = count - moved < p_buffer->capacity - source ? count - moved : p_buffer->capacity - source;
+      memmove(p_elements + source - 1, p_elements + source, run * sizeof(int));
+      moved += run;
+    }
+  }
+}
+
+// Doubles the capacity, leaving the elements unwrapped at the start of the new storage
+static void SortedRingBuffer_grow(struct SortedRingBuffer* p_buffer) {
+  size_t capacity = p_buffer->capacity == 0 ? INITIAL_CAPACITY : 2 * p_buffer->capacity;
+  int* p_elements = malloc(capacity * sizeof(int));
+  assert(p_elements != NULL && "Memory allocation failed");
+
+  if (p_buffer->size != 0) {
+    size_t first_run = p_buffer->capacity - p_buffer->head;
+    if (first_run > p_buffer->size) {
+      first_run = p_buffer->size;
+    }
+    memcpy(p_elements, p_buffer->p_elements + p_buffer->head, first_run * sizeof(int));
+    memcpy(p_elements + first_run, p_buffer->p_elements, (p_buffer->size - first_run) * sizeof(int));
+  }
+  free(p_buffer->p_elements);
+
+  p_buffer->p_elements = p_elements;
+  p_buffer->capacity = capacity;
+  p_buffer->head = 0;
+}
+
+struct SortedRingBuffer* SortedRingBuffer_new() {
+  // Allocate memory for the buffer
+  struct SortedRingBuffer* p_buffer = malloc(sizeof(struct SortedRingBuffer));
+  assert(p_buffer != NULL && "Memory allocation failed");
+
+  // Initialize the buffer. Storage is allocated on first insertion
+  p_buffer->p_elements = NULL;
+  p_buffer->capacity = 0;
+  p_buffer->head = 0;
+  p_buffer->size = 0;
+  return p_buffer;
+}
+
+void SortedRingBuffer_insert(struct SortedRingBuffer* p_buffer, int element) {
+  assert(p_buffer != NULL && "List is NULL");
+
+  if (p_buffer->size == p_buffer->capacity) {
+    SortedRingBuffer_grow(p_buffer);
+  }
+
+  // Open a gap at the insertion point by moving the shorter side
+  size_t index = SortedRingBuffer_lowerBound(p_buffer, element);
+  if (index < p_buffer->size - index) {
+    SortedRingBuffer_shiftDown(p_buffer, 0, index);
+    p_buffer->head = SortedRingBuffer_slot(p_buffer, (size_t) -1);
+  } else {
+    SortedRingBuffer_shiftUp(p_buffer, index, p_buffer->size - index);
+  }
+
+  p_buffer->p_elements[SortedRingBuffer_slot(p_buffer, index)] = element;
+  p_buffer->size++;
+}
+
+void SortedRingBuffer_remove(struct SortedRingBuffer* p_buffer, size_t index) {
+  assert(p_buffer != NULL && "List is NULL");
+  assert(index < p_buffer->size && "Index out of bounds");
+
+  // Close the gap by moving the shorter side
+  if (index < p_buffer->size - index - 1) {
+    SortedRingBuffer_shiftUp(p_buffer, 0, index);
+    p_buffer->head = SortedRingBuffer_slot(p_buffer, 1);
+  } else {
+    SortedRingBuffer_shiftDown(p_buffer, index + 1, p_buffer->size - index - 1);
+  }
+
+  p_buffer->size--;
+}
+
+void SortedRingBuffer_print(const struct SortedRingBuffer* p_buffer) {
+  assert(p_buffer != NULL && "List is NULL");
+
+  for (size_t i = 0; i < p_buffer->size; i++) {
+    printf("%d ", p_buffer->p_elements[SortedRingBuffer_slot(p_buffer, i)]);
+  }
+  printf("\n");
+}
+
+void SortedRingBuffer_free(struct SortedRingBuffer** p_p_buffer) {
+  assert(p_p_buffer != NULL && "Pointer is NULL");
+
+  struct SortedRingBuffer* p_buffer = *p_p_buffer;
+  assert(p_buffer != NULL && "List is NULL");
+
+  // Free the storage and the buffer structure
+  free(p_buffer->p_elements);
+  free(p_buffer);
+
+  // Set the pointer to the buffer to NULL
+  *p_p_buffer = NULL;
+}
+
+bool SortedRingBuffer_equals(const struct SortedRingBuffer* p_buffer1, const struct SortedRingBuffer* p_buffer2) {
+  assert(p_buffer1 != NULL && "List 1 is NULL");
+  assert(p_buffer2 != NULL && "List 2 is NULL");
+
+  if (p_buffer1->size != p_buffer2->size) {
+    return false;
+  }
+
+  for (size_t i = 0; i < p_buffer1->size; i++) {
+    if (p_buffer1->p_elements[SortedRingBuffer_slot(p_buffer1, i)] != p_buffer2->p_elements[SortedRingBuffer_slot(p_buffer2, i)]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int SortedRingBuffer_get(const struct SortedRingBuffer* p_buffer, size_t index) {
+  assert(p_buffer != NULL && "List is NULL");
+  assert(index < p_buffer->size && "Index out of bounds");
+
+  return p_buffer->p_elements[SortedRingBuffer_slot(p_buffer, index)];
+}
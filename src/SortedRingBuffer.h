@@ -0,0 +1,28 @@
+// Data Structures, University of Malaga
+//
+// Sorted sequence stored contiguously in a growable ring buffer. Offers the
+// same operations as CircularLinkedList, but insertion points are found by
+// binary search and elements are moved with memmove instead of walking nodes.
+
+#ifndef SORTED_RING_BUFFER_H
+#define SORTED_RING_BUFFER_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+struct SortedRingBuffer {
+  int* p_elements; // storage for the elements
+  size_t capacity; // number of slots in p_elements (zero or a power of two)
+  size_t head;     // slot holding the first element
+  size_t size;     // number of elements in the buffer
+};
+
+struct SortedRingBuffer* SortedRingBuffer_new();
+void SortedRingBuffer_insert(struct SortedRingBuffer* p_buffer, int element);
+void SortedRingBuffer_remove(struct SortedRingBuffer* p_buffer, size_t index);
+void SortedRingBuffer_print(const struct SortedRingBuffer* p_buffer);
+void SortedRingBuffer_free(struct SortedRingBuffer** p_p_buffer);
+bool SortedRingBuffer_equals(const struct SortedRingBuffer* p_buffer1, const struct SortedRingBuffer* p_buffer2);
+int SortedRingBuffer_get(const struct SortedRingBuffer* p_buffer, size_t index);
+
+#endif
@@ -0,0 +1,8 @@
+// Data Structures, University of Malaga
+
+#include "TimestampList.h"
+#include "test/unit/UnitTest.h"
+
+#define TIMESTAMP_LESS(a, b) ((a) < (b))
+
+IMPLEMENT_CIRCULAR_LINKED_LIST(TimestampList, int64_t, TIMESTAMP_LESS)
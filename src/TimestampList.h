@@ -0,0 +1,15 @@
+// Data Structures, University of Malaga
+//
+// Sorted circular linked list of int64_t timestamps, generated from
+// CircularLinkedListTemplate.h.
+
+#ifndef TIMESTAMP_LIST_H
+#define TIMESTAMP_LIST_H
+
+#include <stdint.h>
+
+#include "CircularLinkedListTemplate.h"
+
+DECLARE_CIRCULAR_LINKED_LIST(TimestampList, int64_t)
+
+#endif
@@ -0,0 +1,243 @@
+// Data Structures, University of Malaga
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "UnrolledCircularLinkedList.h"
+#include "test/unit/UnitTest.h"
+
+_Static_assert(sizeof(struct UnrolledNode) == UNROLLED_NODE_ALIGNMENT, "A node must fill a cache line");
+
+static struct UnrolledNode* UnrolledNode_new(void) {
+  // Aligned so that the node does not straddle two cache lines. MSVC lacks
+  // aligned_alloc and its aligned allocations need their own free
+#if defined(_MSC_VER)
+  struct UnrolledNode* p_node = malloc(sizeof(struct UnrolledNode));
+#else
+  struct UnrolledNode* p_node = aligned_alloc(UNROLLED_NODE_ALIGNMENT, sizeof(struct UnrolledNode));
+#endif
+  assert(p_node != NULL && "Memory allocation failed");
+
+  // Unused slots hold INT_MAX so that they never compare smaller than any element
+  p_node->count = 0;
+  for (int i = 0; i < UNROLLED_NODE_CAPACITY; i++) {
+    p_node->elements[i] = INT_MAX;
+  }
+  return p_node;
+}
+
+// Number of elements in the node that are smaller than element, i.e. the
+// position where element should be inserted
+static int UnrolledNode_countLess(const struct UnrolledNode* p_node, int element) {
+#if defined(__SSE2__) && defined(__GNUC__)
+  // Compare the whole cache line at once. Unused slots hold INT_MAX, which is
+  // never smaller than element, so they do not need to be masked out
+  __m128i key = _mm_set1_epi32(element);
+  __m128i block0 = _mm_loadu_si128((const __m128i*) &p_node->elements[0]);
+  __m128i block1 = _mm_loadu_si128((const __m128i*) &p_node->elements[4]);
+  __m128i block2 = _mm_loadu_si128((const __m128i*) &p_node->elements[8]);
+  int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(block0, key)))
+           | _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(block1, key))) << 4
+           | _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(block2, key))) << 8;
+  return __builtin_popcount((unsigned) mask) + (p_node->elements[12] < element);
+#else
+  int i = 0;
+  while (i < p_node->count && p_node->elements[i] < element) {
+    i++;
+  }
+  return i;
+#endif
+}
+
+struct UnrolledCircularLinkedList* UnrolledCircularLinkedList_new() {
+  // Allocate memory for the list
+  struct UnrolledCircularLinkedList* p_list = malloc(sizeof(struct UnrolledCircularLinkedList));
+  assert(p_list != NULL && "Memory allocation failed");
+
+  // Initialize the list
+  p_list->p_last = NULL;
+  p_list->size = 0;
+  return p_list;
+}
+
+void UnrolledCircularLinkedList_insert(struct UnrolledCircularLinkedList* p_list, int element) {
+  assert(p_list != NULL && "List is NULL");
+
+  if (p_list->size == 0) {
+    // The list is empty
+    struct UnrolledNode* p_node = UnrolledNode_new();
+    p_node->p_next = p_node;
+    p_list->p_last = p_node;
+  }
+
+  // Find the first node whose largest element is not smaller than element
+  // (or the last node if there is none)
+  struct UnrolledNode* p_node = p_list->p_last->p_next;
+  while (p_node != p_list->p_last && p_node->elements[p_node->count - 1] < element) {
+    p_node = p_node->p_next;
+  }
+
+  if (p_node->count == UNROLLED_NODE_CAPACITY) {
+    // The node is full: move its upper half to a new node that follows it
+    const int kept = (UNROLLED_NODE_CAPACITY + 1) / 2;
+    const int moved = UNROLLED_NODE_CAPACITY - kept;
+
+    struct UnrolledNode* p_new = UnrolledNode_new();
+    memcpy(p_new->elements, p_node->elements + kept, moved * sizeof(int));
+    p_new->count = moved;
+    for (int i = kept; i < UNROLLED_NODE_CAPACITY; i++) {
+      p_node->elements[i] = INT_MAX;
+    }
+    p_node->count = kept;
+
+    p_new->p_next = p_node->p_next;
+    p_node->p_next = p_new;
+    if (p_node == p_list->p_last) {
+      p_list->p_last = p_new;
+    }
+
+    // Choose the half where element belongs
+    if (element > p_node->elements[kept - 1]) {
+      p_node = p_new;
+    }
+  }
+
+  // Shift larger elements one slot up and store element in the gap
+  int position = UnrolledNode_countLess(p_node, element);
+  memmove(p_node->elements + position + 1, p_node->elements + position, (p_node->count - position) * sizeof(int));
+  p_node->elements[position] = element;
+  p_node->count++;
+
+  // Update the size of the list
+  p_list->size++;
+}
+
+void UnrolledCircularLinkedList_remove(struct UnrolledCircularLinkedList* p_list, size_t index) {
+  assert(p_list != NULL && "List is NULL");
+  assert(index < p_list->size && "Index out of bounds");
+
+  struct UnrolledNode* p_previous = p_list->p_last; // Last node
+  struct UnrolledNode* p_node = p_previous->p_next; // First node
+
+  // Find the node holding the element
+  while (index >= (size_t) p_node->count) {
+    index -= p_node->count;
+    p_previous = p_node;
+    p_node = p_node->p_next;
+  }
+
+  // Close the gap left by the element
+  memmove(p_node->elements + index, p_node->elements + index + 1, (p_node->count - index - 1) * sizeof(int));
+  p_node->count--;
+  p_node->elements[p_node->count] = INT_MAX;
+  p_list->size--;
+
+  if (p_node->count == 0) {
+    // The node is empty: unlink and free it
+    if (p_node == p_previous) {
+      p_list->p_last = NULL;
+    } else {
+      p_previous->p_next = p_node->p_next;
+      if (p_node == p_list->p_last) {
+        p_list->p_last = p_previous;
+      }
+    }
+    free(p_node);
+  } else if (p_node != p_list->p_last) {
+    // Merge an underfull node with its successor if both fit in one node
+    struct UnrolledNode* p_next = p_node->p_next;
+    if (p_node->count < UNROLLED_NODE_CAPACITY / 2 && p_node->count + p_next->count <= UNROLLED_NODE_CAPACITY) {
+      memcpy(p_node->elements + p_node->count, p_next->elements, p_next->count * sizeof(int));
+      p_node->count += p_next->count;
+      p_node->p_next = p_next->p_next;
+      if (p_next == p_list->p_last) {
+        p_list->p_last = p_node;
+      }
+      free(p_next);
+    }
+  }
+}
+
+void UnrolledCircularLinkedList_print(const struct UnrolledCircularLinkedList* p_list) {
+  assert(p_list != NULL && "List is NULL");
+
+  if (p_list->size != 0) {
+    const struct UnrolledNode* p_first = p_list->p_last->p_next;
+    const struct UnrolledNode* p_current = p_first;
+
+    do {
+      for (int i = 0; i < p_current->count; i++) {
+        printf("%d ", p_current->elements[i]);
+      }
+      p_current = p_current->p_next;
+    } while (p_current != p_first);
+  }
+  printf("\n");
+}
+
+void UnrolledCircularLinkedList_free(struct UnrolledCircularLinkedList** p_p_list) {
+  assert(p_p_list != NULL && "Pointer is NULL");
+
+  struct UnrolledCircularLinkedList* p_list = *p_p_list;
+  assert(p_list != NULL && "List is NULL");
+
+  // Break the cycle and free all the nodes in the list
+  if (p_list->p_last != NULL) {
+    struct UnrolledNode* p_current = p_list->p_last->p_next;
+    p_list->p_last->p_next = NULL;
+    while (p_current != NULL) {
+      struct UnrolledNode* p_toDelete = p_current;
+      p_current = p_current->p_next;
+      free(p_toDelete);
+    }
+  }
+
+  // Free the list structure
+  free(p_list);
+
+  // Set the pointer to the list to NULL
+  *p_p_list = NULL;
+}
+
+bool UnrolledCircularLinkedList_equals(const struct UnrolledCircularLinkedList* p_list1, const struct UnrolledCircularLinkedList* p_list2) {
+  assert(p_list1 != NULL && "List 1 is NULL");
+  assert(p_list2 != NULL && "List 2 is NULL");
+
+  if (p_list1->size != p_list2->size) {
+    return false;
+  }
+
+  if (p_list1->size == 0) {
+    return true;
+  }
+
+  // Nodes of both lists may be split differently, so walk them independently
+  const struct UnrolledNode* p_current1 = p_list1->p_last->p_next;
+  const struct UnrolledNode* p_current2 = p_list2->p_last->p_next;
+  int i1 = 0, i2 = 0;
+
+  for (size_t i = 0; i < p_list1->size; i++) {
+    if (i1 == p_current1->count) {
+      p_current1 = p_current1->p_next;
+      i1 = 0;
+    }
+    if (i2 == p_current2->count) {
+      p_current2 = p_current2->p_next;
+      i2 = 0;
+    }
+    if (p_current1->elements[i1] != p_current2->elements[i2]) {
+      return false;
+    }
+    i1++;
+    i2++;
+  }
+
+  return true;
+}
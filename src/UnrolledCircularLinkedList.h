@@ -0,0 +1,34 @@
+// Data Structures, University of Malaga
+//
+// Sorted circular linked list whose nodes store a small sorted array of
+// elements. Each node fills one 64-byte cache line, so a traversal touches
+// one line per UNROLLED_NODE_CAPACITY elements instead of one per element.
+
+#ifndef UNROLLED_CIRCULAR_LINKED_LIST_H
+#define UNROLLED_CIRCULAR_LINKED_LIST_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#define UNROLLED_NODE_CAPACITY 13 // elements per node: 8 + 4 + 13 * 4 = 64 bytes
+#define UNROLLED_NODE_ALIGNMENT 64 // nodes are allocated at cache line boundaries
+
+struct UnrolledNode {
+  struct UnrolledNode* p_next;              // pointer to the next node
+  int count;                                // number of elements in the node
+  int elements[UNROLLED_NODE_CAPACITY];     // sorted elements, unused slots hold INT_MAX
+};
+
+struct UnrolledCircularLinkedList {
+  struct UnrolledNode* p_last; // pointer to the last node
+  size_t size;                 // number of elements in the list
+};
+
+struct UnrolledCircularLinkedList* UnrolledCircularLinkedList_new();
+void UnrolledCircularLinkedList_insert(struct UnrolledCircularLinkedList* p_list, int element);
+void UnrolledCircularLinkedList_remove(struct UnrolledCircularLinkedList* p_list, size_t index);
+void UnrolledCircularLinkedList_print(const struct UnrolledCircularLinkedList* p_list);
+void UnrolledCircularLinkedList_free(struct UnrolledCircularLinkedList** p_p_list);
+bool UnrolledCircularLinkedList_equals(const struct UnrolledCircularLinkedList* p_list1, const struct UnrolledCircularLinkedList* p_list2);
+
+#endif
@@ -0,0 +1,559 @@
+// Data Structures, University of Malaga
+//
+// Benchmark of the sorted list implementations, built as its own executable
+// (bench). For every backend, workload and size it times a number of warmup
+// runs, which are discarded, and of measured repetitions, each on freshly
+// built lists, and reports the time per operation as CSV or JSON. Sizes grow
+// tenfold. As most workloads take quadratic time, a workload stops growing
+// when a run at the next size is expected to exceed the time budget, judging
+// by how run times grew between the last two sizes. Run bench --help for the
+// options.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "CircularLinkedList.h"
+#include "UnrolledCircularLinkedList.h"
+#include "SortedRingBuffer.h"
+#include "RunLengthCircularLinkedList.h"
+#include "ArenaCircularLinkedList.h"
+#include "ConcurrentCircularLinkedList.h"
+
+/*============================================================================*/
+/* Backends under comparison, accessed through a common set of operations    */
+/*============================================================================*/
+struct Backend {
+  const char* name;
+  void* (*create)(void);
+  void (*insert)(void* p_list, int element);
+  void (*remove)(void* p_list, size_t index);
+  bool (*equals)(const void* p_list1, const void* p_list2);
+  size_t (*to_buffer)(const void* p_list, char* p_buffer, size_t size); // NULL if not supported
+  void (*destroy)(void* p_list);
+};
+
+static void* CircularLinkedList_newBench(void) { return CircularLinkedList_new(); }
+static void CircularLinkedList_insertBench(void* p_list, int element) { CircularLinkedList_insert(p_list, element); }
+static void CircularLinkedList_removeBench(void* p_list, size_t index) { CircularLinkedList_remove(p_list, index); }
+static bool CircularLinkedList_equalsBench(const void* p_list1, const void* p_list2) { return CircularLinkedList_equals(p_list1, p_list2); }
+static size_t CircularLinkedList_to_bufferBench(const void* p_list, char* p_buffer, size_t size) { return CircularLinkedList_to_buffer(p_list, p_buffer, size); }
+static void CircularLinkedList_freeBench(void* p_list) { struct CircularLinkedList* p = p_list; CircularLinkedList_free(&p); }
+
+static void* UnrolledCircularLinkedList_newBench(void) { return UnrolledCircularLinkedList_new(); }
+static void UnrolledCircularLinkedList_insertBench(void* p_list, int element) { UnrolledCircularLinkedList_insert(p_list, element); }
+static void UnrolledCircularLinkedList_removeBench(void* p_list, size_t index) { UnrolledCircularLinkedList_remove(p_list, index); }
+static bool UnrolledCircularLinkedList_equalsBench(const void* p_list1, const void* p_list2) { return UnrolledCircularLinkedList_equals(p_list1, p_list2); }
+static void UnrolledCircularLinkedList_freeBench(void* p_list) { struct UnrolledCircularLinkedList* p = p_list; UnrolledCircularLinkedList_free(&p); }
+
+static void* SortedRingBuffer_newBench(void) { return SortedRingBuffer_new(); }
+static void SortedRingBuffer_insertBench(void* p_buffer, int element) { SortedRingBuffer_insert(p_buffer, element); }
+static void SortedRingBuffer_removeBench(void* p_buffer, size_t index) { SortedRingBuffer_remove(p_buffer, index); }
+static bool SortedRingBuffer_equalsBench(const void* p_buffer1, const void* p_buffer2) { return SortedRingBuffer_equals(p_buffer1, p_buffer2); }
+static void SortedRingBuffer_freeBench(void* p_buffer) { struct SortedRingBuffer* p = p_buffer; SortedRingBuffer_free(&p); }
+
+static void* RunLengthCircularLinkedList_newBench(void) { return RunLengthCircularLinkedList_new(); }
+static void RunLengthCircularLinkedList_insertBench(void* p_list, int element) { RunLengthCircularLinkedList_insert(p_list, element); }
+static void RunLengthCircularLinkedList_removeBench(void* p_list, size_t index) { RunLengthCircularLinkedList_remove(p_list, index); }
+static bool RunLengthCircularLinkedList_equalsBench(const void* p_list1, const void* p_list2) { return RunLengthCircularLinkedList_equals(p_list1, p_list2); }
+static void RunLengthCircularLinkedList_freeBench(void* p_list) { struct RunLengthCircularLinkedList* p = p_list; RunLengthCircularLinkedList_free(&p); }
+
+static void* ArenaCircularLinkedList_newBench(void) { return ArenaCircularLinkedList_new(); }
+static void ArenaCircularLinkedList_insertBench(void* p_list, int element) { ArenaCircularLinkedList_insert(p_list, element); }
+static void ArenaCircularLinkedList_removeBench(void* p_list, size_t index) { ArenaCircularLinkedList_remove(p_list, index); }
+static bool ArenaCircularLinkedList_equalsBench(const void* p_list1, const void* p_list2) { return ArenaCircularLinkedList_equals(p_list1, p_list2); }
+static void ArenaCircularLinkedList_freeBench(void* p_list) { struct ArenaCircularLinkedList* p = p_list; ArenaCircularLinkedList_free(&p); }
+
+static const struct Backend backends[] = {
+  { "CircularLinkedList", CircularLinkedList_newBench, CircularLinkedList_insertBench, CircularLinkedList_removeBench, CircularLinkedList_equalsBench, CircularLinkedList_to_bufferBench, CircularLinkedList_freeBench },
+  { "UnrolledCircularLinkedList", UnrolledCircularLinkedList_newBench, UnrolledCircularLinkedList_insertBench, UnrolledCircularLinkedList_removeBench, UnrolledCircularLinkedList_equalsBench, NULL, UnrolledCircularLinkedList_freeBench },
+  { "SortedRingBuffer", SortedRingBuffer_newBench, SortedRingBuffer_insertBench, SortedRingBuffer_removeBench, SortedRingBuffer_equalsBench, NULL, SortedRingBuffer_freeBench },
+  { "RunLengthCircularLinkedList", RunLengthCircularLinkedList_newBench, RunLengthCircularLinkedList_insertBench, RunLengthCircularLinkedList_removeBench, RunLengthCircularLinkedList_equalsBench, NULL, RunLengthCircularLinkedList_freeBench },
+  { "ArenaCircularLinkedList", ArenaCircularLinkedList_newBench, ArenaCircularLinkedList_insertBench, ArenaCircularLinkedList_removeBench, ArenaCircularLinkedList_equalsBench, NULL, ArenaCircularLinkedList_freeBench },
+};
+
+/*============================================================================*/
+/* Timing and pseudo-random numbers                                           */
+/*============================================================================*/
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+static uint64_t random_next(uint64_t* p_state) {
+  // xorshift64*
+  uint64_t x = *p_state;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  *p_state = x;
+  return x * 0x2545F4914F6CDD1DULL;
+}
+
+#define SEED 0x9E3779B97F4A7C15ULL
+#define DUPLICATE_KEYS 100 // distinct elements in duplicate-heavy workloads
+
+/*============================================================================*/
+/* Workloads. Each run builds its lists, times the operations under test and */
+/* returns the elapsed time, storing the number of operations timed          */
+/*============================================================================*/
+static int compareDescending(const void* p_a, const void* p_b) {
+  int a = *(const int*) p_a;
+  int b = *(const int*) p_b;
+  return (a < b) - (a > b);
+}
+
+// Builds a list of n random elements. They are inserted from the largest one
+// down, which takes linear time for lists that insert at the front cheaply
+static void* build(const struct Backend* p_backend, size_t n) {
+  int* p_elements = malloc(n * sizeof(int));
+  if (p_elements == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(EXIT_FAILURE);
+  }
+  uint64_t state = SEED;
+  for (size_t i = 0; i < n; i++) {
+    p_elements[i] = (int) (random_next(&state) >> 34);
+  }
+  qsort(p_elements, n, sizeof(int), compareDescending);
+
+  void* p_list = p_backend->create();
+  for (size_t i = 0; i < n; i++) {
+    p_backend->insert(p_list, p_elements[i]);
+  }
+  free(p_elements);
+  return p_list;
+}
+
+static double insertRandom(const struct Backend* p_backend, size_t n, size_t* p_operations) {
+  uint64_t state = SEED;
+  void* p_list = p_backend->create();
+  double start = now_seconds();
+  for (size_t i = 0; i < n; i++) {
+    p_backend->insert(p_list, (int) (random_next(&state) >> 34));
+  }
+  double elapsed = now_seconds() - start;
+  p_backend->destroy(p_list);
+  *p_operations = n;
+  return elapsed;
+}
+
+static double insertAscending(const struct Backend* p_backend, size_t n, size_t* p_operations) {
+  void* p_list = p_backend->create();
+  double start = now_seconds();
+  for (size_t i = 0; i < n; i++) {
+    p_backend->insert(p_list, (int) i);
+  }
+  double elapsed = now_seconds() - start;
+  p_backend->destroy(p_list);
+  *p_operations = n;
+  return elapsed;
+}
+
+static double insertDescending(const struct Backend* p_backend, size_t n, size_t* p_operations) {
+  void* p_list = p_backend->create();
+  double start = now_seconds();
+  for (size_t i = n; i > 0; i--) {
+    p_backend->insert(p_list, (int) i);
+  }
+  double elapsed = now_seconds() - start;
+  p_backend->destroy(p_list);
+  *p_operations = n;
+  return elapsed;
+}
+
+static double insertDuplicates(const struct Backend* p_backend, size_t n, size_t* p_operations) {
+  uint64_t state = SEED;
+  void* p_list = p_backend->create();
+  double start = now_seconds();
+  for (size_t i = 0; i < n; i++) {
+    p_backend->insert(p_list, (int) (random_next(&state) % DUPLICATE_KEYS));
+  }
+  double elapsed = now_seconds() - start;
+  p_backend->destroy(p_list);
+  *p_operations = n;
+  return elapsed;
+}
+
+static double removeFront(const struct Backend* p_backend, size_t n, size_t* p_operations) {
+  void* p_list = build(p_backend, n);
+  double start = now_seconds();
+  for (size_t i = 0; i < n; i++) {
+    p_backend->remove(p_list, 0);
+  }
+  double elapsed = now_seconds() - start;
+  p_backend->destroy(p_list);
+  *p_operations = n;
+  return elapsed;
+}
+
+static double removeBack(const struct Backend* p_backend, size_t n, size_t* p_operations) {
+  void* p_list = build(p_backend, n);
+  double start = now_seconds();
+  for (size_t size = n; size > 0; size--) {
+    p_backend->remove(p_list, size - 1);
+  }
+  double elapsed = now_seconds() - start;
+  p_backend->destroy(p_list);
+  *p_operations = n;
+  return elapsed;
+}
+
+static double removeRandom(const struct Backend* p_backend, size_t n, size_t* p_operations) {
+  uint64_t state = ~SEED;
+  void* p_list = build(p_backend, n);
+  double start = now_seconds();
+  for (size_t size = n; size > 0; size--) {
+    p_backend->remove(p_list, (size_t) (random_next(&state) % size));
+  }
+  double elapsed = now_seconds() - start;
+  p_backend->destroy(p_list);
+  *p_operations = n;
+  return elapsed;
+}
+
+// Linear workloads repeat their operation so that small sizes are measurable
+static size_t rounds(size_t n) {
+  return n >= 100000 ? 1 : 100000 / n;
+}
+
+static double compare(const struct Backend* p_backend, size_t n, size_t* p_operations) {
+  void* p_list1 = build(p_backend, n);
+  void* p_list2 = build(p_backend, n);
+  size_t count = rounds(n);
+  bool equal = true;
+  double start = now_seconds();
+  for (size_t i = 0; i < count; i++) {
+    equal = p_backend->equals(p_list1, p_list2) && equal;
+  }
+  double elapsed = now_seconds() - start;
+  p_backend->destroy(p_list1);
+  p_backend->destroy(p_list2);
+  if (!equal) {
+    fprintf(stderr, "%s: equal lists compare as different\n", p_backend->name);
+    exit(EXIT_FAILURE);
+  }
+  *p_operations = count;
+  return elapsed;
+}
+
+static double printToBuffer(const struct Backend* p_backend, size_t n, size_t* p_operations) {
+  void* p_list = build(p_backend, n);
+  size_t size = p_backend->to_buffer(p_list, NULL, 0) + 1;
+  char* p_buffer = malloc(size);
+  if (p_buffer == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(EXIT_FAILURE);
+  }
+  size_t count = rounds(n);
+  double start = now_seconds();
+  for (size_t i = 0; i < count; i++) {
+    p_backend->to_buffer(p_list, p_buffer, size);
+  }
+  double elapsed = now_seconds() - start;
+  free(p_buffer);
+  p_backend->destroy(p_list);
+  *p_operations = count;
+  return elapsed;
+}
+
+// Time per element freed
+static double release(const struct Backend* p_backend, size_t n, size_t* p_operations) {
+  void* p_list = build(p_backend, n);
+  double start = now_seconds();
+  p_backend->destroy(p_list);
+  double elapsed = now_seconds() - start;
+  *p_operations = n;
+  return elapsed;
+}
+
+struct Workload {
+  const char* name;
+  double (*run)(const struct Backend* p_backend, size_t n, size_t* p_operations);
+};
+
+static const struct Workload workloads[] = {
+  { "insert_random", insertRandom },
+  { "insert_ascending", insertAscending },
+  { "insert_descending", insertDescending },
+  { "insert_duplicates", insertDuplicates },
+  { "remove_front", removeFront },
+  { "remove_back", removeBack },
+  { "remove_random", removeRandom },
+  { "equals", compare },
+  { "print_to_buffer", printToBuffer },
+  { "free", release },
+};
+
+/*============================================================================*/
+/* Concurrent scaling: a fixed number of mixed operations split among threads */
+/*============================================================================*/
+#define SCALING_OPERATIONS 100000
+#define SCALING_KEY_RANGE 1024
+#define SCALING_MAX_THREADS 64
+
+struct Worker {
+  pthread_t thread;
+  struct ConcurrentCircularLinkedList* p_list;
+  size_t operations;
+  uint64_t seed;
+};
+
+static void* runWorker(void* p_argument) {
+  struct Worker* p_worker = p_argument;
+  uint64_t state = p_worker->seed;
+  int pending[64]; // elements inserted by this worker and not removed yet
+  size_t count = 0;
+
+  // 20% inserts, 20% removals of elements inserted before (so that the size
+  // of the list stays stable) and 60% lookups, on keys from a small range
+  for (size_t i = 0; i < p_worker->operations; i++) {
+    uint64_t r = random_next(&state);
+    int key = (int) ((r >> 8) % SCALING_KEY_RANGE);
+    uint64_t kind = r % 5;
+    if (kind == 0 && count < sizeof(pending) / sizeof(pending[0])) {
+      ConcurrentCircularLinkedList_insert(p_worker->p_list, key);
+      pending[count++] = key;
+    } else if (kind <= 1 && count > 0) {
+      ConcurrentCircularLinkedList_remove_value(p_worker->p_list, pending[--count]);
+    } else {
+      ConcurrentCircularLinkedList_contains(p_worker->p_list, key);
+    }
+  }
+  return NULL;
+}
+
+static double runScaling(size_t threads, size_t* p_operations) {
+  struct ConcurrentCircularLinkedList* p_list = ConcurrentCircularLinkedList_new();
+  uint64_t state = SEED;
+  for (int i = 0; i < SCALING_KEY_RANGE / 2; i++) {
+    ConcurrentCircularLinkedList_insert(p_list, (int) (random_next(&state) % SCALING_KEY_RANGE));
+  }
+
+  struct Worker workers[SCALING_MAX_THREADS];
+  double start = now_seconds();
+  for (size_t t = 0; t < threads; t++) {
+    workers[t].p_list = p_list;
+    workers[t].operations = SCALING_OPERATIONS / threads;
+    workers[t].seed = SEED * (t + 1);
+    pthread_create(&workers[t].thread, NULL, runWorker, &workers[t]);
+  }
+  for (size_t t = 0; t < threads; t++) {
+    pthread_join(workers[t].thread, NULL);
+  }
+  double elapsed = now_seconds() - start;
+
+  ConcurrentCircularLinkedList_free(&p_list);
+  *p_operations = threads * (SCALING_OPERATIONS / threads);
+  return elapsed;
+}
+
+/*============================================================================*/
+/* Measurement and output                                                     */
+/*============================================================================*/
+struct Options {
+  const char* backend; // NULL for all of them
+  bool json;
+  size_t min_size;
+  size_t max_size;
+  int warmup;
+  int repetitions;
+  double budget; // seconds
+  bool scaling;
+};
+
+struct Result {
+  const char* backend;
+  const char* workload;
+  size_t size;
+  size_t operations; // per repetition
+  double min;        // nanoseconds per operation
+  double median;
+  double mean;
+};
+
+static int compareDoubles(const void* p_a, const void* p_b) {
+  double a = *(const double*) p_a;
+  double b = *(const double*) p_b;
+  return (a > b) - (a < b);
+}
+
+static bool first = true;
+
+static void report(const struct Options* p_options, const struct Result* p_result) {
+  if (p_options->json) {
+    printf("%s\n  {\"backend\": \"%s\", \"workload\": \"%s\", \"size\": %zu, \"repetitions\": %d, \"operations\": %zu, \"min_ns\": %.3f, \"median_ns\": %.3f, \"mean_ns\": %.3f}",
+           first ? "[" : ",", p_result->backend, p_result->workload, p_result->size, p_options->repetitions, p_result->operations, p_result->min, p_result->median, p_result->mean);
+  } else {
+    if (first) {
+      printf("backend,workload,size,repetitions,operations,min_ns,median_ns,mean_ns\n");
+    }
+    printf("%s,%s,%zu,%d,%zu,%.3f,%.3f,%.3f\n",
+           p_result->backend, p_result->workload, p_result->size, p_options->repetitions, p_result->operations, p_result->min, p_result->median, p_result->mean);
+  }
+  fflush(stdout);
+  first = false;
+}
+
+// Runs warmup and measured repetitions and summarizes the time per operation.
+// Returns the longest measured run, in seconds, including building its lists
+static double measure(const struct Options* p_options, struct Result* p_result, double (*run)(const void* p_context, size_t n, size_t* p_operations), const void* p_context) {
+  double* p_times = malloc((size_t) p_options->repetitions * sizeof(double));
+  if (p_times == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(EXIT_FAILURE);
+  }
+  size_t operations = 0;
+  for (int i = 0; i < p_options->warmup; i++) {
+    run(p_context, p_result->size, &operations);
+  }
+
+  double longest = 0;
+  double total = 0;
+  for (int i = 0; i < p_options->repetitions; i++) {
+    double start = now_seconds();
+    double elapsed = run(p_context, p_result->size, &operations);
+    double whole = now_seconds() - start;
+    longest = whole > longest ? whole : longest;
+    p_times[i] = elapsed * 1e9 / (double) (operations == 0 ? 1 : operations);
+    total += p_times[i];
+  }
+  qsort(p_times, (size_t) p_options->repetitions, sizeof(double), compareDoubles);
+
+  p_result->operations = operations;
+  p_result->min = p_times[0];
+  p_result->median = p_options->repetitions % 2 == 1 ? p_times[p_options->repetitions / 2]
+                                                     : (p_times[p_options->repetitions / 2 - 1] + p_times[p_options->repetitions / 2]) / 2;
+  p_result->mean = total / p_options->repetitions;
+  free(p_times);
+  return longest;
+}
+
+// Adapters from workloads and scaling runs to measure
+struct WorkloadContext {
+  const struct Backend* p_backend;
+  const struct Workload* p_workload;
+};
+
+static double runWorkload(const void* p_context, size_t n, size_t* p_operations) {
+  const struct WorkloadContext* p_workloadContext = p_context;
+  return p_workloadContext->p_workload->run(p_workloadContext->p_backend, n, p_operations);
+}
+
+static double runScalingWorkload(const void* p_context, size_t threads, size_t* p_operations) {
+  (void) p_context;
+  return runScaling(threads, p_operations);
+}
+
+static void usage(const char* p_program) {
+  fprintf(stderr,
+          "Usage: %s [options]\n"
+          "  --backend NAME      benchmark only this backend (default: all)\n"
+          "  --format csv|json   output format (default: csv)\n"
+          "  --min-size N        smallest list size (default: 100)\n"
+          "  --max-size N        largest list size (default: 1000000)\n"
+          "  --warmup N          discarded runs per measurement (default: 1)\n"
+          "  --repetitions N     measured runs per measurement (default: 5)\n"
+          "  --budget SECONDS    largest expected run time for a workload to keep growing (default: 1)\n"
+          "  --scaling           also measure ConcurrentCircularLinkedList with 1 to %d threads\n"
+          "Backends:",
+          p_program, SCALING_MAX_THREADS);
+  for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); b++) {
+    fprintf(stderr, " %s", backends[b].name);
+  }
+  fprintf(stderr, "\n");
+}
+
+static bool parseOptions(int argc, char* argv[], struct Options* p_options) {
+  for (int i = 1; i < argc; i++) {
+    const char* p_option = argv[i];
+    const char* p_value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (strcmp(p_option, "--scaling") == 0) {
+      p_options->scaling = true;
+      continue;
+    }
+    if (p_value == NULL) {
+      return false;
+    }
+    i++;
+    if (strcmp(p_option, "--backend") == 0) {
+      p_options->backend = p_value;
+    } else if (strcmp(p_option, "--format") == 0 && (strcmp(p_value, "csv") == 0 || strcmp(p_value, "json") == 0)) {
+      p_options->json = strcmp(p_value, "json") == 0;
+    } else if (strcmp(p_option, "--min-size") == 0) {
+      p_options->min_size = strtoull(p_value, NULL, 10);
+    } else if (strcmp(p_option, "--max-size") == 0) {
+      p_options->max_size = strtoull(p_value, NULL, 10);
+    } else if (strcmp(p_option, "--warmup") == 0) {
+      p_options->warmup = atoi(p_value);
+    } else if (strcmp(p_option, "--repetitions") == 0) {
+      p_options->repetitions = atoi(p_value);
+    } else if (strcmp(p_option, "--budget") == 0) {
+      p_options->budget = atof(p_value);
+    } else {
+      return false;
+    }
+  }
+  return p_options->min_size > 0 && p_options->min_size <= p_options->max_size && p_options->warmup >= 0 && p_options->repetitions > 0;
+}
+
+int main(int argc, char* argv[]) {
+  struct Options options = { NULL, false, 100, 1000000, 1, 5, 1.0, false };
+  if (!parseOptions(argc, argv, &options)) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  bool found = options.backend == NULL;
+  for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); b++) {
+    const struct Backend* p_backend = &backends[b];
+    if (options.backend != NULL && strcmp(options.backend, p_backend->name) != 0) {
+      continue;
+    }
+    found = true;
+
+    for (size_t w = 0; w < sizeof(workloads) / sizeof(workloads[0]); w++) {
+      const struct Workload* p_workload = &workloads[w];
+      if (p_workload->run == printToBuffer && p_backend->to_buffer == NULL) {
+        continue;
+      }
+      struct WorkloadContext context = { p_backend, p_workload };
+      double previous = 0;
+      for (size_t n = options.min_size; n <= options.max_size; n *= 10) {
+        struct Result result = { p_backend->name, p_workload->name, n, 0, 0, 0, 0 };
+        double longest = measure(&options, &result, runWorkload, &context);
+        report(&options, &result);
+
+        // Assume linear growth until there are two sizes to compare
+        double growth = previous > 0 && longest > previous ? longest / previous : 10;
+        if (longest * growth > options.budget) {
+          break;
+        }
+        previous = longest;
+      }
+    }
+  }
+  if (!found) {
+    fprintf(stderr, "Unknown backend %s\n", options.backend);
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (options.scaling) {
+    // The size of these results is the number of threads
+    for (size_t threads = 1; threads <= SCALING_MAX_THREADS; threads *= 2) {
+      struct Result result = { "ConcurrentCircularLinkedList", "mixed_threads", threads, 0, 0, 0, 0 };
+      measure(&options, &result, runScalingWorkload, NULL);
+      report(&options, &result);
+    }
+  }
+
+  if (options.json) {
+    printf("%s\n", first ? "[]" : "\n]");
+  }
+  return EXIT_SUCCESS;
+}
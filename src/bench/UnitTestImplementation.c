@@ -0,0 +1,9 @@
+// Data Structures, University of Malaga
+//
+// The list implementations route their allocations through the memory
+// tracker of the unit test framework, so the benchmark links its
+// implementation too. Tracking stays off outside test runs, and then the
+// tracker just forwards to the standard functions.
+
+#define UNIT_TEST_IMPLEMENTATION
+#include "test/unit/UnitTest.h"
@@ -408,6 +408,7 @@ void UT_mark_memory_as_baseline(void);
 void *_UT_malloc(size_t size, const char *file, int line);
 void *_UT_calloc(size_t num, size_t size, const char *file, int line);
 void *_UT_realloc(void *old_ptr, size_t new_size, const char *file, int line);
+void *_UT_aligned_alloc(size_t alignment, size_t size, const char *file, int line);
 void _UT_free(void *ptr, const char *file, int line);
 
 #ifdef UNIT_TEST_MEMORY_TRACKING
@@ -415,6 +416,7 @@ void _UT_free(void *ptr, const char *file, int line);
 #define malloc(size) _UT_malloc(size, __FILE__, __LINE__)
 #define calloc(num, size) _UT_calloc(num, size, __FILE__, __LINE__)
 #define realloc(ptr, size) _UT_realloc(ptr, size, __FILE__, __LINE__)
+#define aligned_alloc(alignment, size) _UT_aligned_alloc(alignment, size, __FILE__, __LINE__)
 #define free(ptr) _UT_free(ptr, __FILE__, __LINE__)
 #endif // UNIT_TEST_MEMORY_TRACKING
 
@@ -1422,10 +1424,12 @@ float _UT_calculate_similarity_ratio(const char *s1, const char *s2);
 #pragma push_macro("malloc")
 #pragma push_macro("calloc")
 #pragma push_macro("realloc")
+#pragma push_macro("aligned_alloc")
 #pragma push_macro("free")
 #undef malloc
 #undef calloc
 #undef realloc
+#undef aligned_alloc
 #undef free
 
 #define _UT_SERIALIZATION_MARKER '\x1F'
@@ -2798,6 +2802,35 @@ void *_UT_realloc(void *old_ptr, size_t new_size, const char *file, int line)
     return new_ptr;
 }
 
+void *_UT_aligned_alloc(size_t alignment, size_t size, const char *file, int line)
+{
+    if (!_UT_mem_tracking_enabled || !_UT_mem_tracking_is_active)
+        return aligned_alloc(alignment, size);
+    void *ptr = aligned_alloc(alignment, size);
+    if (ptr)
+    {
+        UT_total_bytes_allocated += size;
+        _UT_MemInfo *info = (_UT_MemInfo *)malloc(sizeof(_UT_MemInfo));
+        if (info)
+        {
+            // fill with random data to help catch uninitialized memory usage
+            for (size_t i = 0; i < size; i++)
+            {
+                ((unsigned char *)ptr)[i] = (unsigned char)(rand() % 256);
+            }
+            info->address = ptr;
+            info->size = size;
+            info->file = file;
+            info->line = line;
+            info->is_baseline = 0;
+            info->next = _UT_mem_head;
+            _UT_mem_head = info;
+            UT_alloc_count++;
+        }
+    }
+    return ptr;
+}
+
 void _UT_free(void *ptr, const char *file, int line)
 {
     if (ptr == NULL)
@@ -2829,6 +2862,7 @@ void _UT_free(void *ptr, const char *file, int line)
 }
 
 #pragma pop_macro("free")
+#pragma pop_macro("aligned_alloc")
 #pragma pop_macro("realloc")
 #pragma pop_macro("calloc")
 #pragma pop_macro("malloc")
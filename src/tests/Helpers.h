@@ -5,15 +5,26 @@
 
 struct X {
   int i;
+  unsigned b;
   struct X* x;
 };
 
 struct Y {
-  struct X* x; 
+  _Alignas(64) struct X* x; 
   size_t s;    
+  size_t t, l, r;
+  struct X* f;
+  size_t c;
+  unsigned u;
+  struct X n[3];
+#ifdef CIRCULAR_LINKED_LIST_FINGERPRINT
+  unsigned long long h;
+#endif
 };
 
 struct Y* _n(int G[],size_t F);
+struct Y* _g(int(*G)(size_t,void*),void*H,size_t F,int T);
+void _d(struct Y*A,int T);
 void _p(char*H, size_t I, struct Y*A);
 int _c(struct Y*F,struct Y*G);
 int _v(struct Y*A, char*buf, size_t size);
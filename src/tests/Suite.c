@@ -3,7 +3,15 @@
 /* Pepe Gallardo, 2025                                                        */
 /*============================================================================*/
 
+#include <limits.h>
+
 #include "CircularLinkedList.h"
+#include "UnrolledCircularLinkedList.h"
+#include "SortedRingBuffer.h"
+#include "RunLengthCircularLinkedList.h"
+#include "ArenaCircularLinkedList.h"
+#include "TimestampList.h"
+#include "ConcurrentCircularLinkedList.h"
 #include "Helpers.h"
 
 #define UNIT_TEST_DECLARATION
@@ -14,8 +22,45 @@
 /* TEST HELPERS                                                               */
 /*============================================================================*/
 
+_Static_assert(sizeof(struct Y) == sizeof(struct CircularLinkedList), "struct Y must mirror struct CircularLinkedList");
+
 static struct CircularLinkedList* _create_test_list(const int values[], size_t count) {
-    return (struct CircularLinkedList*) _n((int*)values, count);
+    struct CircularLinkedList* list = (struct CircularLinkedList*) _n((int*)values, count);
+#ifdef CIRCULAR_LINKED_LIST_FINGERPRINT
+    CircularLinkedList_rehash(list);
+#endif
+    return list;
+}
+
+// Fixture lists hold all their nodes in the same block as the list structure,
+// with elements given by a generator that must not decrease with the index.
+// They are built in linear time without per-node allocations, so lists of
+// millions of elements are cheap. Untracked fixtures are invisible to memory
+// checks. Fixtures are read-only: they may be compared, cloned or inspected,
+// but never passed to functions that relink or free nodes, and are released,
+// in O(1), with _free_fixture_list
+static struct CircularLinkedList* _create_fixture_list(int (*generator)(size_t index, void* context), void* context, size_t count, bool tracked) {
+    struct CircularLinkedList* list = (struct CircularLinkedList*) _g(generator, context, count, tracked);
+#ifdef CIRCULAR_LINKED_LIST_FINGERPRINT
+    CircularLinkedList_rehash(list);
+#endif
+    return list;
+}
+
+static void _free_fixture_list(struct CircularLinkedList** list, bool tracked) {
+    _d((struct Y*)*list, tracked);
+    *list = NULL;
+}
+
+// Generates first, first + step, first + 2 * step, ...
+struct _Progression {
+    int first;
+    int step;
+};
+
+static int _progression(size_t index, void* context) {
+    const struct _Progression* progression = context;
+    return progression->first + (int) index * progression->step;
 }
 
 static bool _equalLists(const struct CircularLinkedList* l1, const struct CircularLinkedList* l2) {
@@ -27,7 +72,32 @@ static void __p(char* buf, size_t size, struct CircularLinkedList* list) {
 }
 
 static bool _validateList(struct CircularLinkedList* list, char* buf, size_t size) {
-    return _v((struct Y*)list, buf, size);
+    if (!_v((struct Y*)list, buf, size)) {
+        return false;
+    }
+#ifdef CIRCULAR_LINKED_LIST_FINGERPRINT
+    uint64_t fingerprint = list->fingerprint;
+    if (CircularLinkedList_rehash(list) != fingerprint) {
+        snprintf(buf, size, "Stale fingerprint: stored %llx but elements hash to %llx", (unsigned long long) fingerprint, (unsigned long long) list->fingerprint);
+        return false;
+    }
+#endif
+    return true;
+}
+
+// Checks that the nodes are consecutive in memory, in traversal order
+static bool _isContiguous(const struct CircularLinkedList* list) {
+    if (list->size == 0) {
+        return true;
+    }
+    const struct Node* first = list->p_last->p_next;
+    const struct Node* node = first;
+    for (size_t i = 0; i < list->size; i++, node = node->p_next) {
+        if (node != first + i) {
+            return false;
+        }
+    }
+    return node == first;
 }
 
 #define EQUAL_CIRCULAR_LINKED_LIST(expected, actual) EQUAL_BY(expected, actual, _equalLists, __p)
@@ -66,45 +136,45 @@ TEST_ASSERTION_FAILURE_WITH_SIMILAR_MESSAGE(CircularLinkedList_insert, "Assertio
     CircularLinkedList_insert(NULL, 10);
 }
 TEST_CASE(CircularLinkedList_insert, "Inserts into an empty list") {
-    // check that after insertion, the list is correctly updated and one node was allocated
+    // check that after insertion, the list is correctly updated and an inline node was used instead of allocating one
     struct CircularLinkedList* list = _create_test_list(NULL, 0);
     struct CircularLinkedList* expected = _create_test_list((int[]){10}, 1);
     UT_mark_memory_as_baseline();
     ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
         CircularLinkedList_insert(list, 10);
-    }, 1, 0, sizeof(struct Node), 0);
+    }, 0, 0, 0, 0);
     VALIDATE_CIRCULAR_LINKED_LIST(list);
     EQUAL_CIRCULAR_LINKED_LIST(expected, list);
 }
 TEST_CASE(CircularLinkedList_insert, "Inserts smaller element at the beginning") {
-    // check that after insertion, the list is correctly updated and one node was allocated
+    // check that after insertion, the list is correctly updated and an inline node was used instead of allocating one
     struct CircularLinkedList* list = _create_test_list((int[]){10, 20, 30}, 3);
     struct CircularLinkedList* expected = _create_test_list((int[]){5, 10, 20, 30}, 4);
     UT_mark_memory_as_baseline();
     ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
         CircularLinkedList_insert(list, 5);
-    }, 1, 0, sizeof(struct Node), 0);
+    }, 0, 0, 0, 0);
     VALIDATE_CIRCULAR_LINKED_LIST(list);
     EQUAL_CIRCULAR_LINKED_LIST(expected, list);
 }
 TEST_CASE(CircularLinkedList_insert, "Inserts larger element at the end") {
-    // check that after insertion, the list is correctly updated and one node was allocated
+    // check that after insertion, the list is correctly updated and an inline node was used instead of allocating one
     struct CircularLinkedList* list = _create_test_list((int[]){10, 20, 30}, 3);
     struct CircularLinkedList* expected = _create_test_list((int[]){10, 20, 30, 40}, 4);
     UT_mark_memory_as_baseline();
     ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
         CircularLinkedList_insert(list, 40);
-    }, 1, 0, sizeof(struct Node), 0);
+    }, 0, 0, 0, 0);
     VALIDATE_CIRCULAR_LINKED_LIST(list);
 }
 TEST_CASE(CircularLinkedList_insert, "Inserts an element in the middle") {
-    // check that after insertion, the list is correctly updated and one node was allocated
+    // check that after insertion, the list is correctly updated and an inline node was used instead of allocating one
     struct CircularLinkedList* list = _create_test_list((int[]){10, 20, 40}, 3);
     struct CircularLinkedList* expected = _create_test_list((int[]){10, 20, 30, 40}, 4);
     UT_mark_memory_as_baseline();
     ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
         CircularLinkedList_insert(list, 30);
-    }, 1, 0, sizeof(struct Node), 0);
+    }, 0, 0, 0, 0);
     VALIDATE_CIRCULAR_LINKED_LIST(list);
     EQUAL_CIRCULAR_LINKED_LIST(expected, list);
 }
@@ -311,6 +381,2048 @@ TEST_CASE(CircularLinkedList_equals, "Returns false when first list is longer")
     REFUTE(CircularLinkedList_equals(list1, list2));
 }
 
+/*============================================================================*/
+/* TEST SUITE G: CircularLinkedList cursors                                   */
+/*============================================================================*/
+TEST_CASE(CircularLinkedList_insert_at_hint, "Appends at the tail when element is not smaller than the last one") {
+    // tail fast path: an inline node used, cursor left on the new last node
+    struct CircularLinkedList* list = _create_test_list((int[]){10, 20, 30}, 3);
+    struct CircularLinkedList* expected = _create_test_list((int[]){10, 20, 30, 30}, 4);
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_cursor_begin(list);
+    UT_mark_memory_as_baseline();
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        CircularLinkedList_insert_at_hint(list, &cursor, 30);
+    }, 0, 0, 0, 0);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    EQUAL_CIRCULAR_LINKED_LIST(expected, list);
+    EQUAL_SIZE_T(3, cursor.index);
+    EQUAL_POINTER(list->p_last, cursor.p_previous->p_next);
+}
+TEST_CASE(CircularLinkedList_insert_at_hint, "Builds a sorted list from a near-sorted stream") {
+    // each element is inserted at or after the previous one, except for a few outliers
+    UT_disable_leak_check();
+    struct CircularLinkedList* list = _create_test_list(NULL, 0);
+    struct CircularLinkedList* expected = _create_test_list((int[]){1, 2, 3, 4, 5, 6, 7, 8, 9}, 9);
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_cursor_begin(list);
+    int stream[] = {2, 4, 3, 5, 9, 6, 7, 1, 8};
+    for (size_t i = 0; i < sizeof(stream) / sizeof(stream[0]); i++) {
+        CircularLinkedList_insert_at_hint(list, &cursor, stream[i]);
+        VALIDATE_CIRCULAR_LINKED_LIST(list);
+        EQUAL_INT(stream[i], CircularLinkedList_cursor_element(list, &cursor));
+    }
+    EQUAL_CIRCULAR_LINKED_LIST(expected, list);
+}
+TEST_CASE(CircularLinkedList_insert_at_hint, "Reports the index of the inserted element") {
+    // insertion before the cursor restarts from the first node
+    UT_disable_leak_check();
+    struct CircularLinkedList* list = _create_test_list((int[]){10, 20, 30, 40}, 4);
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_cursor_begin(list);
+    CircularLinkedList_cursor_next(list, &cursor);
+    CircularLinkedList_cursor_next(list, &cursor);
+    CircularLinkedList_insert_at_hint(list, &cursor, 35);
+    EQUAL_SIZE_T(3, cursor.index);
+    CircularLinkedList_insert_at_hint(list, &cursor, 15);
+    EQUAL_SIZE_T(1, cursor.index);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+}
+TEST_ASSERTION_FAILURE_WITH_SIMILAR_MESSAGE(CircularLinkedList_remove_at_cursor, "Assertion should fail on a cursor past the end with \"Cursor out of bounds\" message", "Cursor out of bounds") {
+    // a cursor moved past the last node does not designate any element
+    struct CircularLinkedList* list = _create_test_list((int[]){5}, 1);
+    UT_mark_memory_as_baseline();
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_cursor_begin(list);
+    CircularLinkedList_cursor_next(list, &cursor);
+    CircularLinkedList_remove_at_cursor(list, &cursor);
+}
+TEST_CASE(CircularLinkedList_remove_at_cursor, "Removes the element at the cursor and moves to the next one") {
+    // one node freed, cursor designates the following element
+    struct CircularLinkedList* list = _create_test_list((int[]){5, 10, 15, 20}, 4);
+    struct CircularLinkedList* expected = _create_test_list((int[]){5, 15, 20}, 3);
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_cursor_begin(list);
+    CircularLinkedList_cursor_next(list, &cursor);
+    UT_mark_memory_as_baseline();
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        CircularLinkedList_remove_at_cursor(list, &cursor);
+    }, 0, 1, 0, sizeof(struct Node));
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    EQUAL_CIRCULAR_LINKED_LIST(expected, list);
+    EQUAL_INT(15, CircularLinkedList_cursor_element(list, &cursor));
+}
+TEST_CASE(CircularLinkedList_remove_at_cursor, "Wraps around after removing the last element") {
+    // removing the last node updates p_last and moves the cursor to the first node
+    UT_disable_leak_check();
+    struct CircularLinkedList* list = _create_test_list((int[]){5, 10}, 2);
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_cursor_begin(list);
+    CircularLinkedList_cursor_next(list, &cursor);
+    CircularLinkedList_remove_at_cursor(list, &cursor);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    EQUAL_SIZE_T(0, cursor.index);
+    EQUAL_INT(5, CircularLinkedList_cursor_element(list, &cursor));
+    CircularLinkedList_remove_at_cursor(list, &cursor);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    ASSERT_NULL(list->p_last);
+}
+
+/*============================================================================*/
+/* TEST SUITE H: CircularLinkedList iteration and reductions                  */
+/*============================================================================*/
+static bool _isEven(int element, void* context) {
+    (void) context;
+    return element % 2 == 0;
+}
+
+static bool _isGreaterThan(int element, void* context) {
+    return element > *(int*) context;
+}
+
+TEST_CASE(CircularLinkedList_for_each, "Visits every element once and in order") {
+    // a list longer than the prefetch distance is traversed exactly size times
+    UT_disable_leak_check();
+    int values[] = {1, 2, 3, 5, 8, 13, 21, 34, 55, 89};
+    struct CircularLinkedList* list = _create_test_list(values, 10);
+    size_t i = 0;
+    int element;
+    CircularLinkedList_for_each(element, list) {
+        EQUAL_INT(values[i], element);
+        i++;
+    }
+    EQUAL_SIZE_T(10, i);
+}
+TEST_CASE(CircularLinkedList_for_each, "Does not visit any element of an empty list") {
+    // the body must not run for an empty list
+    UT_disable_leak_check();
+    struct CircularLinkedList* list = _create_test_list(NULL, 0);
+    int element;
+    size_t visited = 0;
+    CircularLinkedList_for_each(element, list) {
+        (void) element;
+        visited++;
+    }
+    EQUAL_SIZE_T(0, visited);
+}
+TEST_CASE(CircularLinkedList_sum, "Adds all the elements without overflowing int") {
+    // the result is accumulated in a long long
+    UT_disable_leak_check();
+    struct CircularLinkedList* list = _create_test_list((int[]){-5, 2000000000, 2000000000}, 3);
+    ASSERT(CircularLinkedList_sum(list) == 3999999995LL);
+    EQUAL_INT(0, (int) CircularLinkedList_sum(_create_test_list(NULL, 0)));
+}
+TEST_CASE(CircularLinkedList_count_if, "Counts the elements satisfying a predicate") {
+    // predicates receive the user supplied context
+    UT_disable_leak_check();
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 4, 7, 8, 10}, 6);
+    int threshold = 5;
+    EQUAL_SIZE_T(4, CircularLinkedList_count_if(list, _isEven, NULL));
+    EQUAL_SIZE_T(3, CircularLinkedList_count_if(list, _isGreaterThan, &threshold));
+}
+TEST_ASSERTION_FAILURE_WITH_SIMILAR_MESSAGE(CircularLinkedList_min, "Assertion should fail on an empty list with \"List is empty\" message", "List is empty") {
+    // an empty list has no minimum
+    CircularLinkedList_min(_create_test_list(NULL, 0));
+}
+TEST_CASE(CircularLinkedList_min, "Returns the first and last elements as minimum and maximum") {
+    // both are read directly from the first and last nodes
+    UT_disable_leak_check();
+    struct CircularLinkedList* list = _create_test_list((int[]){-3, 0, 7, 7}, 4);
+    EQUAL_INT(-3, CircularLinkedList_min(list));
+    EQUAL_INT(7, CircularLinkedList_max(list));
+}
+
+/*============================================================================*/
+/* TEST SUITE I: CircularLinkedList searches                                  */
+/*============================================================================*/
+TEST_CASE(CircularLinkedList_contains, "Finds present elements and rejects absent ones") {
+    // elements inside the range, outside the range and in the gaps
+    UT_disable_leak_check();
+    struct CircularLinkedList* list = _create_test_list((int[]){10, 20, 20, 30}, 4);
+    ASSERT(CircularLinkedList_contains(list, 10));
+    ASSERT(CircularLinkedList_contains(list, 20));
+    ASSERT(CircularLinkedList_contains(list, 30));
+    REFUTE(CircularLinkedList_contains(list, 5));
+    REFUTE(CircularLinkedList_contains(list, 25));
+    REFUTE(CircularLinkedList_contains(list, 35));
+    REFUTE(CircularLinkedList_contains(_create_test_list(NULL, 0), 10));
+}
+TEST_CASE(CircularLinkedList_lower_bound, "Returns a cursor at the first element not smaller than the given one") {
+    // the cursor can be used to read and remove the element found
+    UT_disable_leak_check();
+    struct CircularLinkedList* list = _create_test_list((int[]){10, 20, 20, 30}, 4);
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_lower_bound(list, 20);
+    EQUAL_SIZE_T(1, cursor.index);
+    EQUAL_INT(20, CircularLinkedList_cursor_element(list, &cursor));
+    cursor = CircularLinkedList_lower_bound(list, 21);
+    EQUAL_SIZE_T(3, cursor.index);
+    EQUAL_INT(30, CircularLinkedList_cursor_element(list, &cursor));
+    cursor = CircularLinkedList_lower_bound(list, -1);
+    EQUAL_SIZE_T(0, cursor.index);
+    EQUAL_INT(10, CircularLinkedList_cursor_element(list, &cursor));
+}
+TEST_CASE(CircularLinkedList_lower_bound, "Returns a cursor past the end for elements larger than the last") {
+    // index is size and the cursor follows the last node
+    UT_disable_leak_check();
+    struct CircularLinkedList* list = _create_test_list((int[]){10, 20, 30}, 3);
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_lower_bound(list, 31);
+    EQUAL_SIZE_T(3, cursor.index);
+    EQUAL_POINTER(list->p_last, cursor.p_previous);
+}
+TEST_CASE(CircularLinkedList_count, "Counts occurrences of an element") {
+    // duplicates at the beginning, middle and end of the list
+    UT_disable_leak_check();
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 1, 2, 3, 3, 3, 4, 4}, 8);
+    EQUAL_SIZE_T(2, CircularLinkedList_count(list, 1));
+    EQUAL_SIZE_T(1, CircularLinkedList_count(list, 2));
+    EQUAL_SIZE_T(3, CircularLinkedList_count(list, 3));
+    EQUAL_SIZE_T(2, CircularLinkedList_count(list, 4));
+    EQUAL_SIZE_T(0, CircularLinkedList_count(list, 0));
+    EQUAL_SIZE_T(0, CircularLinkedList_count(list, 5));
+}
+TEST_CASE(CircularLinkedList_count, "Counts all elements of a list holding a single repeated value") {
+    // counting must stop after size nodes even though the list is circular
+    UT_disable_leak_check();
+    struct CircularLinkedList* list = _create_test_list((int[]){7, 7, 7}, 3);
+    EQUAL_SIZE_T(3, CircularLinkedList_count(list, 7));
+}
+
+/*============================================================================*/
+/* TEST SUITE J: CircularLinkedList merge, union and intersection             */
+/*============================================================================*/
+TEST_CASE(CircularLinkedList_merge, "Merges two interleaved lists without allocating or freeing nodes") {
+    // all nodes of the source end up in the destination; source becomes empty
+    struct CircularLinkedList* list1 = _create_test_list((int[]){1, 4, 4, 9}, 4);
+    struct CircularLinkedList* list2 = _create_test_list((int[]){0, 4, 5, 10, 12}, 5);
+    struct CircularLinkedList* expected = _create_test_list((int[]){0, 1, 4, 4, 4, 5, 9, 10, 12}, 9);
+    struct CircularLinkedList* empty = _create_test_list(NULL, 0);
+    UT_mark_memory_as_baseline();
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        CircularLinkedList_merge(list1, list2);
+    }, 0, 0);
+    VALIDATE_CIRCULAR_LINKED_LIST(list1);
+    VALIDATE_CIRCULAR_LINKED_LIST(list2);
+    EQUAL_CIRCULAR_LINKED_LIST(expected, list1);
+    EQUAL_CIRCULAR_LINKED_LIST(empty, list2);
+}
+TEST_CASE(CircularLinkedList_merge, "Merges into and from an empty list") {
+    // p_last must be taken from whichever list is non-empty
+    UT_disable_leak_check();
+    struct CircularLinkedList* list1 = _create_test_list(NULL, 0);
+    struct CircularLinkedList* list2 = _create_test_list((int[]){2, 3}, 2);
+    struct CircularLinkedList* expected = _create_test_list((int[]){2, 3}, 2);
+    CircularLinkedList_merge(list1, list2);
+    VALIDATE_CIRCULAR_LINKED_LIST(list1);
+    EQUAL_CIRCULAR_LINKED_LIST(expected, list1);
+    CircularLinkedList_merge(list1, list2);
+    VALIDATE_CIRCULAR_LINKED_LIST(list1);
+    EQUAL_CIRCULAR_LINKED_LIST(expected, list1);
+}
+TEST_CASE(CircularLinkedList_union_into, "Keeps the largest number of occurrences of each element") {
+    // matched source nodes are freed, the others are moved and count as linked
+    struct CircularLinkedList* list1 = _create_test_list((int[]){1, 3, 3, 5}, 4);
+    struct CircularLinkedList* list2 = _create_test_list((int[]){3, 5, 5, 7}, 4);
+    struct CircularLinkedList* expected = _create_test_list((int[]){1, 3, 3, 5, 5, 7}, 6);
+    UT_mark_memory_as_baseline();
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        CircularLinkedList_union_into(list1, list2);
+    }, 0, 2, 0, 2 * sizeof(struct Node));
+    VALIDATE_CIRCULAR_LINKED_LIST(list1);
+    VALIDATE_CIRCULAR_LINKED_LIST(list2);
+    EQUAL_CIRCULAR_LINKED_LIST(expected, list1);
+    EQUAL_SIZE_T(0, list2->size);
+    EQUAL_SIZE_T(2, list1->linked);
+}
+TEST_CASE(CircularLinkedList_intersect_into, "Keeps the smallest number of occurrences of each element") {
+    // unmatched destination nodes are freed and the source is left untouched
+    struct CircularLinkedList* list1 = _create_test_list((int[]){1, 3, 3, 5, 8}, 5);
+    struct CircularLinkedList* list2 = _create_test_list((int[]){3, 5, 5, 7}, 4);
+    struct CircularLinkedList* expected1 = _create_test_list((int[]){3, 5}, 2);
+    struct CircularLinkedList* expected2 = _create_test_list((int[]){3, 5, 5, 7}, 4);
+    UT_mark_memory_as_baseline();
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        CircularLinkedList_intersect_into(list1, list2);
+    }, 0, 3, 0, 3 * sizeof(struct Node));
+    VALIDATE_CIRCULAR_LINKED_LIST(list1);
+    EQUAL_CIRCULAR_LINKED_LIST(expected1, list1);
+    EQUAL_CIRCULAR_LINKED_LIST(expected2, list2);
+}
+TEST_CASE(CircularLinkedList_intersect_into, "Empties the destination when lists are disjoint") {
+    // every destination node is freed
+    UT_disable_leak_check();
+    struct CircularLinkedList* list1 = _create_test_list((int[]){1, 2}, 2);
+    struct CircularLinkedList* list2 = _create_test_list((int[]){3, 4}, 2);
+    CircularLinkedList_intersect_into(list1, list2);
+    VALIDATE_CIRCULAR_LINKED_LIST(list1);
+    EQUAL_SIZE_T(0, list1->size);
+}
+
+/*============================================================================*/
+/* TEST SUITE K: CircularLinkedList concat, split and splice                  */
+/*============================================================================*/
+TEST_CASE(CircularLinkedList_concat, "Appends a list with larger elements") {
+    // no memory is allocated or freed and the source becomes empty
+    struct CircularLinkedList* list1 = _create_test_list((int[]){1, 2, 3}, 3);
+    struct CircularLinkedList* list2 = _create_test_list((int[]){3, 7}, 2);
+    struct CircularLinkedList* expected = _create_test_list((int[]){1, 2, 3, 3, 7}, 5);
+    UT_mark_memory_as_baseline();
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        CircularLinkedList_concat(list1, list2);
+    }, 0, 0);
+    VALIDATE_CIRCULAR_LINKED_LIST(list1);
+    VALIDATE_CIRCULAR_LINKED_LIST(list2);
+    EQUAL_CIRCULAR_LINKED_LIST(expected, list1);
+    EQUAL_SIZE_T(0, list2->size);
+}
+TEST_CASE(CircularLinkedList_concat, "Prepends a list with smaller elements") {
+    // p_last of the destination is kept
+    UT_disable_leak_check();
+    struct CircularLinkedList* list1 = _create_test_list((int[]){5, 6}, 2);
+    struct CircularLinkedList* list2 = _create_test_list((int[]){1, 2, 3}, 3);
+    struct CircularLinkedList* expected = _create_test_list((int[]){1, 2, 3, 5, 6}, 5);
+    CircularLinkedList_concat(list1, list2);
+    VALIDATE_CIRCULAR_LINKED_LIST(list1);
+    EQUAL_CIRCULAR_LINKED_LIST(expected, list1);
+}
+TEST_ASSERTION_FAILURE_WITH_SIMILAR_MESSAGE(CircularLinkedList_concat, "Assertion should fail on overlapping lists with \"Lists overlap\" message", "Lists overlap") {
+    // concatenating overlapping lists would break the order
+    struct CircularLinkedList* list1 = _create_test_list((int[]){1, 5}, 2);
+    struct CircularLinkedList* list2 = _create_test_list((int[]){3, 7}, 2);
+    UT_mark_memory_as_baseline();
+    CircularLinkedList_concat(list1, list2);
+}
+TEST_CASE(CircularLinkedList_split_at_node, "Moves the nodes from the cursor on to another list") {
+    // no memory is allocated or freed and both parts are valid lists
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3, 4, 5}, 5);
+    struct CircularLinkedList* tail = _create_test_list(NULL, 0);
+    struct CircularLinkedList* expected1 = _create_test_list((int[]){1, 2}, 2);
+    struct CircularLinkedList* expected2 = _create_test_list((int[]){3, 4, 5}, 3);
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_lower_bound(list, 3);
+    UT_mark_memory_as_baseline();
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        CircularLinkedList_split_at_node(tail, list, &cursor);
+    }, 0, 0);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    VALIDATE_CIRCULAR_LINKED_LIST(tail);
+    EQUAL_CIRCULAR_LINKED_LIST(expected1, list);
+    EQUAL_CIRCULAR_LINKED_LIST(expected2, tail);
+}
+TEST_CASE(CircularLinkedList_split_at_node, "Splits at the first node and past the last one") {
+    // splitting at index 0 moves everything, at index size moves nothing
+    UT_disable_leak_check();
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3}, 3);
+    struct CircularLinkedList* tail = _create_test_list(NULL, 0);
+    struct CircularLinkedList* expected = _create_test_list((int[]){1, 2, 3}, 3);
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_lower_bound(list, 4);
+    CircularLinkedList_split_at_node(tail, list, &cursor);
+    EQUAL_SIZE_T(0, tail->size);
+    cursor = CircularLinkedList_cursor_begin(list);
+    CircularLinkedList_split_at_node(tail, list, &cursor);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    VALIDATE_CIRCULAR_LINKED_LIST(tail);
+    EQUAL_SIZE_T(0, list->size);
+    EQUAL_CIRCULAR_LINKED_LIST(expected, tail);
+}
+TEST_CASE(CircularLinkedList_splice_range, "Moves a range of nodes to the end of another list") {
+    // the range is unlinked from the middle of the source
+    struct CircularLinkedList* list1 = _create_test_list((int[]){0, 1}, 2);
+    struct CircularLinkedList* list2 = _create_test_list((int[]){1, 2, 3, 4, 5}, 5);
+    struct CircularLinkedList* expected1 = _create_test_list((int[]){0, 1, 2, 3, 4}, 5);
+    struct CircularLinkedList* expected2 = _create_test_list((int[]){1, 5}, 2);
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_lower_bound(list2, 2);
+    UT_mark_memory_as_baseline();
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        CircularLinkedList_splice_range(list1, list2, &cursor, 3);
+    }, 0, 0);
+    VALIDATE_CIRCULAR_LINKED_LIST(list1);
+    VALIDATE_CIRCULAR_LINKED_LIST(list2);
+    EQUAL_CIRCULAR_LINKED_LIST(expected1, list1);
+    EQUAL_CIRCULAR_LINKED_LIST(expected2, list2);
+}
+TEST_CASE(CircularLinkedList_splice_range, "Moves the trailing range of a list to the front of another") {
+    // taking the last nodes of the source updates its p_last
+    UT_disable_leak_check();
+    struct CircularLinkedList* list1 = _create_test_list((int[]){10, 20}, 2);
+    struct CircularLinkedList* list2 = _create_test_list((int[]){1, 2, 3}, 3);
+    struct CircularLinkedList* expected1 = _create_test_list((int[]){2, 3, 10, 20}, 4);
+    struct CircularLinkedList* expected2 = _create_test_list((int[]){1}, 1);
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_lower_bound(list2, 2);
+    CircularLinkedList_splice_range(list1, list2, &cursor, 2);
+    VALIDATE_CIRCULAR_LINKED_LIST(list1);
+    VALIDATE_CIRCULAR_LINKED_LIST(list2);
+    EQUAL_CIRCULAR_LINKED_LIST(expected1, list1);
+    EQUAL_CIRCULAR_LINKED_LIST(expected2, list2);
+}
+
+/*============================================================================*/
+/* TEST SUITE L: CircularLinkedList bulk removal                              */
+/*============================================================================*/
+TEST_CASE(CircularLinkedList_remove_range, "Removes a range from the middle") {
+    // one node freed per removed element
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3, 4, 5, 6}, 6);
+    struct CircularLinkedList* expected = _create_test_list((int[]){1, 5, 6}, 3);
+    UT_mark_memory_as_baseline();
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        CircularLinkedList_remove_range(list, 1, 4);
+    }, 0, 3, 0, 3 * sizeof(struct Node));
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    EQUAL_CIRCULAR_LINKED_LIST(expected, list);
+}
+TEST_CASE(CircularLinkedList_remove_range, "Removes trailing and complete ranges") {
+    // removing the last nodes updates p_last; removing all empties the list
+    UT_disable_leak_check();
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3, 4}, 4);
+    struct CircularLinkedList* expected = _create_test_list((int[]){1, 2}, 2);
+    CircularLinkedList_remove_range(list, 2, 4);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    EQUAL_CIRCULAR_LINKED_LIST(expected, list);
+    CircularLinkedList_remove_range(list, 0, 2);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    ASSERT_NULL(list->p_last);
+}
+TEST_ASSERTION_FAILURE_WITH_SIMILAR_MESSAGE(CircularLinkedList_remove_range, "Assertion should fail on a range past the end with \"Range out of bounds\" message", "Range out of bounds") {
+    // the range must lie within the list
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3}, 3);
+    UT_mark_memory_as_baseline();
+    CircularLinkedList_remove_range(list, 1, 4);
+}
+TEST_CASE(CircularLinkedList_remove_if, "Removes all the elements satisfying a predicate") {
+    // first and last nodes are among the removed ones
+    struct CircularLinkedList* list = _create_test_list((int[]){2, 3, 4, 5, 6, 7, 8}, 7);
+    struct CircularLinkedList* expected = _create_test_list((int[]){3, 5, 7}, 3);
+    UT_mark_memory_as_baseline();
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        EQUAL_SIZE_T(4, CircularLinkedList_remove_if(list, _isEven, NULL));
+    }, 0, 4, 0, 4 * sizeof(struct Node));
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    EQUAL_CIRCULAR_LINKED_LIST(expected, list);
+}
+TEST_CASE(CircularLinkedList_remove_if, "Empties the list when every element matches") {
+    // p_last must become NULL
+    UT_disable_leak_check();
+    struct CircularLinkedList* list = _create_test_list((int[]){2, 4}, 2);
+    EQUAL_SIZE_T(2, CircularLinkedList_remove_if(list, _isEven, NULL));
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    EQUAL_SIZE_T(0, CircularLinkedList_remove_if(list, _isEven, NULL));
+}
+TEST_CASE(CircularLinkedList_remove_value, "Removes every occurrence of an element") {
+    // runs at the beginning, middle and end; absent values remove nothing
+    UT_disable_leak_check();
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 1, 2, 3, 3, 3, 4, 4}, 8);
+    struct CircularLinkedList* expected = _create_test_list((int[]){2}, 1);
+    EQUAL_SIZE_T(3, CircularLinkedList_remove_value(list, 3));
+    EQUAL_SIZE_T(0, CircularLinkedList_remove_value(list, 5));
+    EQUAL_SIZE_T(2, CircularLinkedList_remove_value(list, 4));
+    EQUAL_SIZE_T(2, CircularLinkedList_remove_value(list, 1));
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    EQUAL_CIRCULAR_LINKED_LIST(expected, list);
+    EQUAL_SIZE_T(1, CircularLinkedList_remove_value(list, 2));
+    EQUAL_SIZE_T(0, CircularLinkedList_remove_value(list, 2));
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+}
+
+/*============================================================================*/
+/* TEST SUITE M: CircularLinkedList serialization                             */
+/*============================================================================*/
+TEST_CASE(CircularLinkedList_to_buffer, "Serializes like CircularLinkedList_print") {
+    // elements separated and followed by a space, then a newline
+    UT_disable_leak_check();
+    char buffer[128];
+    struct CircularLinkedList* list = _create_test_list((int[]){-2147483647 - 1, -10, 0, 7, 99, 100, 2147483647}, 7);
+    const char* expected = "-2147483648 -10 0 7 99 100 2147483647 \n";
+    EQUAL_SIZE_T(strlen(expected), CircularLinkedList_to_buffer(list, buffer, sizeof(buffer)));
+    EQUAL_STRING(expected, buffer);
+    EQUAL_SIZE_T(1, CircularLinkedList_to_buffer(_create_test_list(NULL, 0), buffer, sizeof(buffer)));
+    EQUAL_STRING("\n", buffer);
+}
+TEST_CASE(CircularLinkedList_to_buffer, "Truncates output and reports the full length") {
+    // like snprintf, the result is always NUL terminated
+    UT_disable_leak_check();
+    char buffer[8];
+    struct CircularLinkedList* list = _create_test_list((int[]){123, 4567, 89}, 3);
+    EQUAL_SIZE_T(13, CircularLinkedList_to_buffer(list, buffer, sizeof(buffer)));
+    EQUAL_STRING("123 456", buffer);
+    EQUAL_SIZE_T(13, CircularLinkedList_to_buffer(list, NULL, 0));
+}
+TEST_CASE(CircularLinkedList_write, "Writes long lists in several chunks") {
+    // output larger than the internal buffer must be complete and in order
+    UT_disable_leak_check();
+    enum { COUNT = 3000 };
+    static int values[COUNT];
+    for (int i = 0; i < COUNT; i++) {
+        values[i] = 1000000 + i;
+    }
+    struct CircularLinkedList* list = _create_test_list(values, COUNT);
+    FILE* file = tmpfile();
+    REFUTE_NULL(file);
+    ASSERT(CircularLinkedList_write(list, file));
+    EQUAL_INT(COUNT * 8 + 1, (int) ftell(file));
+    rewind(file);
+    int element;
+    for (int i = 0; i < COUNT; i++) {
+        EQUAL_INT(1, fscanf(file, "%d", &element));
+        EQUAL_INT(values[i], element);
+    }
+    fclose(file);
+}
+
+/*============================================================================*/
+/* TEST SUITE N: CircularLinkedList snapshots                                 */
+/*============================================================================*/
+TEST_CASE(CircularLinkedList_save, "Round trips a list through a delta encoded snapshot") {
+    // close elements are stored as one-byte deltas after the header
+    struct CircularLinkedList* list = _create_test_list((int[]){-3, 0, 0, 5, 100, 101}, 6);
+    const char* path = "CircularLinkedList_save_delta.tmp";
+    ASSERT(CircularLinkedList_save(list, path));
+    FILE* file = fopen(path, "rb");
+    REFUTE_NULL(file);
+    fseek(file, 0, SEEK_END);
+    EQUAL_INT(24 + 5 + 5, (int) ftell(file));
+    fclose(file);
+    UT_mark_memory_as_baseline();
+    struct CircularLinkedList* loaded = CircularLinkedList_load(path);
+    remove(path);
+    REFUTE_NULL(loaded);
+    VALIDATE_CIRCULAR_LINKED_LIST(loaded);
+    EQUAL_CIRCULAR_LINKED_LIST(list, loaded);
+    CircularLinkedList_free(&loaded);
+}
+TEST_CASE(CircularLinkedList_save, "Round trips widely spread elements and empty lists") {
+    // large gaps make raw int32 smaller than varints
+    UT_disable_leak_check();
+    struct CircularLinkedList* list = _create_test_list((int[]){-2147483647 - 1, -1000000000, 1000000000, 2147483647}, 4);
+    const char* path = "CircularLinkedList_save_raw.tmp";
+    ASSERT(CircularLinkedList_save(list, path));
+    struct CircularLinkedList* loaded = CircularLinkedList_load(path);
+    REFUTE_NULL(loaded);
+    VALIDATE_CIRCULAR_LINKED_LIST(loaded);
+    EQUAL_CIRCULAR_LINKED_LIST(list, loaded);
+    struct CircularLinkedList* empty = _create_test_list(NULL, 0);
+    ASSERT(CircularLinkedList_save(empty, path));
+    loaded = CircularLinkedList_load(path);
+    remove(path);
+    REFUTE_NULL(loaded);
+    VALIDATE_CIRCULAR_LINKED_LIST(loaded);
+    EQUAL_SIZE_T(0, loaded->size);
+}
+TEST_CASE(CircularLinkedList_load, "Allocates the list and one block for all the nodes") {
+    // the list is built in a single pass without intermediate buffers; small lists use the inline nodes
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3, 4, 5, 6, 7}, 7);
+    struct CircularLinkedList* small = _create_test_list((int[]){1, 2, 3}, 3);
+    struct CircularLinkedList* loaded = NULL;
+    const char* path = "CircularLinkedList_load_memory.tmp";
+    ASSERT(CircularLinkedList_save(list, path));
+    UT_mark_memory_as_baseline();
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        loaded = CircularLinkedList_load(path);
+    }, 2, 0);
+    ASSERT(_isContiguous(loaded));
+    EQUAL_CIRCULAR_LINKED_LIST(list, loaded);
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        CircularLinkedList_free(&loaded);
+    }, 0, 2);
+    ASSERT(CircularLinkedList_save(small, path));
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        loaded = CircularLinkedList_load(path);
+    }, 1, 0, sizeof(struct CircularLinkedList), 0);
+    remove(path);
+    EQUAL_CIRCULAR_LINKED_LIST(small, loaded);
+    CircularLinkedList_free(&loaded);
+}
+TEST_CASE(CircularLinkedList_load, "Rejects missing, truncated and unsorted snapshots") {
+    // malformed snapshots yield NULL without leaking memory
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3}, 3);
+    const char* path = "CircularLinkedList_load_corrupt.tmp";
+    ASSERT_NULL(CircularLinkedList_load("CircularLinkedList_missing.tmp"));
+    ASSERT(CircularLinkedList_save(list, path));
+    UT_mark_memory_as_baseline();
+    FILE* file = fopen(path, "r+b");
+    fseek(file, 25, SEEK_SET);
+    fputc(0xFF, file); // 1 + 0x7F..., makes the second element wrap below the first
+    fclose(file);
+    ASSERT_NULL(CircularLinkedList_load(path));
+    file = fopen(path, "wb");
+    fwrite("CLLS", 1, 4, file);
+    fclose(file);
+    ASSERT_NULL(CircularLinkedList_load(path));
+    remove(path);
+}
+
+TEST_CASE(CircularLinkedList_load, "Rejects counts too large for the payload") {
+    // 4 * count wraps around to the payload size, which must not let decoding read past the file
+    const char* path = "CircularLinkedList_load_count.tmp";
+    unsigned char snapshot[28] = { 'C', 'L', 'L', 'S', 1, 0, 0, 0 };
+    snapshot[8] = 0x01;
+    snapshot[15] = 0x40; // count = 0x4000000000000001
+    snapshot[16] = 4;    // payload size = 4
+    FILE* file = fopen(path, "wb");
+    fwrite(snapshot, 1, sizeof(snapshot), file);
+    fclose(file);
+    ASSERT_NULL(CircularLinkedList_load(path));
+    snapshot[6] = 1; // the same sizes with delta encoding
+    file = fopen(path, "wb");
+    fwrite(snapshot, 1, sizeof(snapshot), file);
+    fclose(file);
+    ASSERT_NULL(CircularLinkedList_load(path));
+    remove(path);
+}
+
+/*============================================================================*/
+/* TEST SUITE O: CircularLinkedList_fingerprint                               */
+/*============================================================================*/
+TEST_CASE(CircularLinkedList_fingerprint, "Equal lists have equal fingerprints") {
+    // the fingerprint depends on the elements, not on how the list was built
+    UT_disable_leak_check();
+    struct CircularLinkedList* list1 = _create_test_list((int[]){-7, 1, 1, 4}, 4);
+    struct CircularLinkedList* list2 = CircularLinkedList_new();
+    CircularLinkedList_insert(list2, 4);
+    CircularLinkedList_insert(list2, 1);
+    CircularLinkedList_insert(list2, -7);
+    CircularLinkedList_insert(list2, 9);
+    CircularLinkedList_insert(list2, 1);
+    CircularLinkedList_remove(list2, 4);
+    VALIDATE_CIRCULAR_LINKED_LIST(list2);
+    ASSERT(CircularLinkedList_fingerprint(list1) == CircularLinkedList_fingerprint(list2));
+    ASSERT(CircularLinkedList_fingerprint(CircularLinkedList_new()) == 0);
+}
+TEST_CASE(CircularLinkedList_fingerprint, "Lists with different elements have different fingerprints") {
+    // lists of the same size differing only in their last element
+    UT_disable_leak_check();
+    struct CircularLinkedList* list1 = _create_test_list((int[]){1, 2, 3, 4}, 4);
+    struct CircularLinkedList* list2 = _create_test_list((int[]){1, 2, 3, 5}, 4);
+    struct CircularLinkedList* list3 = _create_test_list((int[]){1, 1, 3, 5}, 4);
+    REFUTE(CircularLinkedList_fingerprint(list1) == CircularLinkedList_fingerprint(list2));
+    REFUTE(CircularLinkedList_fingerprint(list2) == CircularLinkedList_fingerprint(list3));
+    REFUTE(CircularLinkedList_equals(list1, list2));
+}
+TEST_CASE(CircularLinkedList_fingerprint, "Is preserved by operations that move nodes between lists") {
+    // the elements of both lists together hash the same before and after
+    UT_disable_leak_check();
+    struct CircularLinkedList* list1 = _create_test_list((int[]){1, 3, 5, 17, 19}, 5);
+    struct CircularLinkedList* list2 = _create_test_list((int[]){10, 12, 14}, 3);
+    uint64_t total = CircularLinkedList_fingerprint(list1) + CircularLinkedList_fingerprint(list2);
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_lower_bound(list1, 3);
+    CircularLinkedList_splice_range(list2, list1, &cursor, 2);
+    struct CircularLinkedList* list3 = CircularLinkedList_new();
+    cursor = CircularLinkedList_lower_bound(list1, 17);
+    CircularLinkedList_split_at_node(list3, list1, &cursor);
+    CircularLinkedList_merge(list1, list2);
+    VALIDATE_CIRCULAR_LINKED_LIST(list1);
+    VALIDATE_CIRCULAR_LINKED_LIST(list2);
+    VALIDATE_CIRCULAR_LINKED_LIST(list3);
+    ASSERT(total == CircularLinkedList_fingerprint(list1) + CircularLinkedList_fingerprint(list3));
+    CircularLinkedList_concat(list1, list3);
+    VALIDATE_CIRCULAR_LINKED_LIST(list1);
+    ASSERT(total == CircularLinkedList_fingerprint(list1));
+    EQUAL_INT(0, (int) CircularLinkedList_fingerprint(list3));
+}
+
+/*============================================================================*/
+/* TEST SUITE P: CircularLinkedListTemplate                                   */
+/*============================================================================*/
+struct Event {
+    int64_t time;
+    int id;
+};
+
+#define EVENT_LESS(a, b) ((a).time < (b).time)
+
+DEFINE_CIRCULAR_LINKED_LIST(EventList, struct Event, EVENT_LESS)
+
+TEST_CASE(TimestampList_insert, "Keeps 64-bit timestamps sorted") {
+    // timestamps beyond the range of int
+    UT_disable_leak_check();
+    struct TimestampList* list = TimestampList_new();
+    TimestampList_insert(list, 1700000000123LL);
+    TimestampList_insert(list, -5);
+    TimestampList_insert(list, 1700000000001LL);
+    TimestampList_insert(list, INT64_MAX);
+    EQUAL_SIZE_T(4, list->size);
+    const struct TimestampList_Node* node = list->p_last->p_next;
+    ASSERT(node->element == -5);
+    ASSERT(node->p_next->element == 1700000000001LL);
+    ASSERT(node->p_next->p_next->element == 1700000000123LL);
+    ASSERT(list->p_last->element == INT64_MAX);
+    EQUAL_POINTER(node, list->p_last->p_next);
+    TimestampList_remove(list, 3);
+    ASSERT(list->p_last->element == 1700000000123LL);
+}
+TEST_CASE(TimestampList_insert, "Allocates exactly one node per element") {
+    // same memory behaviour as CircularLinkedList
+    struct TimestampList* list = TimestampList_new();
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        TimestampList_insert(list, 42);
+    }, 1, 0, sizeof(struct TimestampList_Node), 0);
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        TimestampList_free(&list);
+    }, 0, 2, 0, sizeof(struct TimestampList) + sizeof(struct TimestampList_Node));
+    ASSERT_NULL(list);
+}
+TEST_CASE(EventList_insert, "Orders structs by the comparator and inserts before equal elements") {
+    // only the time takes part in comparisons
+    UT_disable_leak_check();
+    struct EventList* list = EventList_new();
+    EventList_insert(list, (struct Event){20, 1});
+    EventList_insert(list, (struct Event){10, 2});
+    EventList_insert(list, (struct Event){20, 3});
+    const struct EventList_Node* node = list->p_last->p_next;
+    EQUAL_INT(2, node->element.id);
+    EQUAL_INT(3, node->p_next->element.id);
+    EQUAL_INT(1, list->p_last->element.id);
+    struct EventList* other = EventList_new();
+    EventList_insert(other, (struct Event){10, 7});
+    EventList_insert(other, (struct Event){20, 8});
+    REFUTE(EventList_equals(list, other));
+    EventList_insert(other, (struct Event){20, 9});
+    ASSERT(EventList_equals(list, other));
+}
+
+/*============================================================================*/
+/* TEST SUITE Q: ConcurrentCircularLinkedList                                 */
+/*============================================================================*/
+static bool _isSortedConcurrent(struct ConcurrentCircularLinkedList* list) {
+    size_t count = 0;
+    const struct ConcurrentNode* node = list->sentinel.p_next;
+    while (node != &list->sentinel) {
+        if (node->p_next != &list->sentinel && node->p_next->element < node->element) {
+            return false;
+        }
+        node = node->p_next;
+        count++;
+    }
+    return count == ConcurrentCircularLinkedList_size(list);
+}
+
+struct _ConcurrentWorker {
+    struct ConcurrentCircularLinkedList* list;
+    int first;
+};
+
+static void* _insertAndRemoveOdd(void* argument) {
+    struct _ConcurrentWorker* worker = argument;
+    for (int i = 0; i < 1000; i++) {
+        ConcurrentCircularLinkedList_insert(worker->list, worker->first + 4 * i);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        ConcurrentCircularLinkedList_remove_value(worker->list, worker->first + 4 * i + 4);
+    }
+    return NULL;
+}
+
+TEST_CASE(ConcurrentCircularLinkedList_insert, "Keeps elements sorted and size up to date") {
+    // sequential use behaves like CircularLinkedList
+    struct ConcurrentCircularLinkedList* list = ConcurrentCircularLinkedList_new();
+    ConcurrentCircularLinkedList_insert(list, 5);
+    ConcurrentCircularLinkedList_insert(list, -1);
+    ConcurrentCircularLinkedList_insert(list, 5);
+    ConcurrentCircularLinkedList_insert(list, 9);
+    EQUAL_SIZE_T(4, ConcurrentCircularLinkedList_size(list));
+    ASSERT(_isSortedConcurrent(list));
+    ASSERT(ConcurrentCircularLinkedList_contains(list, 5));
+    REFUTE(ConcurrentCircularLinkedList_contains(list, 6));
+    ASSERT(ConcurrentCircularLinkedList_remove_value(list, 5));
+    ASSERT(ConcurrentCircularLinkedList_contains(list, 5));
+    ASSERT(ConcurrentCircularLinkedList_remove_value(list, 9));
+    REFUTE(ConcurrentCircularLinkedList_remove_value(list, 9));
+    EQUAL_SIZE_T(2, ConcurrentCircularLinkedList_size(list));
+    ASSERT(_isSortedConcurrent(list));
+    ConcurrentCircularLinkedList_free(&list);
+    ASSERT_NULL(list);
+}
+TEST_CASE(ConcurrentCircularLinkedList_insert, "Supports concurrent inserts and removals") {
+    // four threads work on interleaved keys; every other key is removed
+    struct ConcurrentCircularLinkedList* list = ConcurrentCircularLinkedList_new();
+    struct _ConcurrentWorker workers[4];
+    pthread_t threads[4];
+    for (int t = 0; t < 4; t++) {
+        workers[t] = (struct _ConcurrentWorker){list, t};
+        pthread_create(&threads[t], NULL, _insertAndRemoveOdd, &workers[t]);
+    }
+    for (int t = 0; t < 4; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    EQUAL_SIZE_T(4 * 500, ConcurrentCircularLinkedList_size(list));
+    ASSERT(_isSortedConcurrent(list));
+    ASSERT(ConcurrentCircularLinkedList_contains(list, 0));
+    REFUTE(ConcurrentCircularLinkedList_contains(list, 4));
+    ASSERT(ConcurrentCircularLinkedList_contains(list, 8 + 3));
+    ConcurrentCircularLinkedList_free(&list);
+}
+
+/*============================================================================*/
+/* TEST SUITE R: CircularLinkedList_compact                                   */
+/*============================================================================*/
+TEST_CASE(CircularLinkedList_compact, "Relocates the nodes into one block in traversal order") {
+    // elements are unchanged and the old nodes are released
+    struct CircularLinkedList* list = _create_test_list((int[]){-4, 0, 0, 8, 15}, 5);
+    struct CircularLinkedList* expected = _create_test_list((int[]){-4, 0, 0, 8, 15}, 5);
+    CircularLinkedList_insert(list, 3);
+    CircularLinkedList_insert(expected, 3);
+    REFUTE(_isContiguous(list));
+    CircularLinkedList_compact(list);
+    ASSERT(_isContiguous(list));
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    EQUAL_CIRCULAR_LINKED_LIST(expected, list);
+    EQUAL_SIZE_T(0, list->linked);
+    CircularLinkedList_free(&list);
+    CircularLinkedList_free(&expected);
+}
+TEST_CASE(CircularLinkedList_compact, "Frees the block once all its nodes are released") {
+    // compacted nodes can be removed or moved to other lists; the leak check covers the block
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3, 4, 5, 6}, 6);
+    CircularLinkedList_compact(list);
+    CircularLinkedList_remove(list, 2);
+    CircularLinkedList_insert(list, 10);
+    struct CircularLinkedList* other = _create_test_list((int[]){20}, 1);
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_lower_bound(list, 5);
+    CircularLinkedList_splice_range(other, list, &cursor, 3);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    VALIDATE_CIRCULAR_LINKED_LIST(other);
+    ASSERT_STDOUT_EQUAL(CircularLinkedList_print(other), "5 6 10 20 \n");
+    CircularLinkedList_compact(other);
+    CircularLinkedList_free(&list);
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        CircularLinkedList_compact(list = _create_test_list(NULL, 0));
+    }, 1, 0, sizeof(struct CircularLinkedList), 0);
+    CircularLinkedList_free(&list);
+    CircularLinkedList_free(&other);
+}
+struct _CompactingWorker {
+    int first;
+    bool valid;
+};
+
+// Builds, compacts, clones, splits and frees lists of its own
+static void* _compactCloneAndSplit(void* argument) {
+    struct _CompactingWorker* worker = argument;
+    worker->valid = true;
+    for (int round = 0; round < 200; round++) {
+        struct CircularLinkedList* list = CircularLinkedList_new();
+        for (int i = 0; i < 64; i++) {
+            CircularLinkedList_insert(list, (worker->first + 37 * i) % 64);
+        }
+        CircularLinkedList_compact(list);
+        struct CircularLinkedList* clone = CircularLinkedList_clone(list);
+        struct CircularLinkedList* tail = CircularLinkedList_new();
+        CircularLinkedList_reserve(tail, 16);
+        struct CircularLinkedList_Cursor cursor = CircularLinkedList_lower_bound(clone, 32);
+        CircularLinkedList_split_at_node(tail, clone, &cursor);
+        CircularLinkedList_remove_range(list, 0, 32);
+        worker->valid = worker->valid && clone->size == 32 && CircularLinkedList_equals(list, tail);
+        CircularLinkedList_free(&list);
+        CircularLinkedList_free(&clone);
+        CircularLinkedList_free(&tail);
+    }
+    return NULL;
+}
+
+TEST_CASE(CircularLinkedList_compact, "Compacts and clones lists on separate threads") {
+    // blocks are found from their nodes, so lists share no state
+    UT_disable_memory_tracking(); // the memory tracker is not thread-safe
+    pthread_t threads[4];
+    struct _CompactingWorker workers[4];
+    for (int t = 0; t < 4; t++) {
+        workers[t] = (struct _CompactingWorker){t, false};
+        pthread_create(&threads[t], NULL, _compactCloneAndSplit, &workers[t]);
+    }
+    for (int t = 0; t < 4; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    UT_enable_memory_tracking();
+    for (int t = 0; t < 4; t++) {
+        ASSERT(workers[t].valid);
+    }
+}
+TEST_CASE(CircularLinkedList_set_auto_compact, "Compacts once searches have visited enough nodes") {
+    // with ratio 1, eight linked nodes in a list of five are compacted after searches visit thirteen
+    struct CircularLinkedList* list = CircularLinkedList_new();
+    CircularLinkedList_set_auto_compact(list, 1);
+    for (int i = 7; i >= 0; i--) {
+        CircularLinkedList_insert(list, i); // searches stop at the first node
+    }
+    CircularLinkedList_remove(list, 7);
+    CircularLinkedList_remove(list, 6);
+    CircularLinkedList_remove(list, 5); // 7 + 6 + 5 nodes visited
+    REFUTE(_isContiguous(list));
+    CircularLinkedList_remove(list, 4);
+    ASSERT(_isContiguous(list));
+    EQUAL_SIZE_T(0, list->linked);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    ASSERT_STDOUT_EQUAL(CircularLinkedList_print(list), "0 1 2 3 \n");
+    CircularLinkedList_insert(list, -1);
+    CircularLinkedList_set_auto_compact(list, 0);
+    for (int i = 0; i < 10; i++) {
+        CircularLinkedList_insert(list, 10);
+    }
+    REFUTE(_isContiguous(list));
+    CircularLinkedList_free(&list);
+}
+TEST_CASE(CircularLinkedList_set_auto_compact, "Never relocates nodes on read-only operations") {
+    // cursors stay valid across full traversals, however many there are
+    struct CircularLinkedList* list = CircularLinkedList_new();
+    struct CircularLinkedList* other = CircularLinkedList_new();
+    CircularLinkedList_set_auto_compact(list, 1);
+    for (int i = 0; i < 8; i++) {
+        CircularLinkedList_insert(list, i);
+        CircularLinkedList_insert(other, i);
+    }
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_lower_bound(list, 5);
+    const struct Node* node = cursor.p_previous->p_next;
+    char buffer[32];
+    for (int i = 0; i < 10; i++) {
+        CircularLinkedList_sum(list);
+        CircularLinkedList_equals(list, other);
+        CircularLinkedList_to_buffer(list, buffer, sizeof(buffer));
+        CircularLinkedList_fingerprint(list);
+    }
+    ASSERT(cursor.p_previous->p_next == node);
+    EQUAL_INT(5, CircularLinkedList_cursor_element(list, &cursor));
+    REFUTE(_isContiguous(list));
+    CircularLinkedList_free(&list);
+    CircularLinkedList_free(&other);
+}
+TEST_CASE(CircularLinkedList_set_auto_compact, "Compacts through cursors and moves them along") {
+    // insertions from the first node visit 15, 16 and 17 nodes, reaching 1 * (19 + 19) on the third
+    struct CircularLinkedList* list = CircularLinkedList_new();
+    CircularLinkedList_set_auto_compact(list, 1);
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_cursor_begin(list);
+    for (int i = 0; i < 16; i++) {
+        CircularLinkedList_insert_at_hint(list, &cursor, 10 * i); // tail fast path, nothing visited
+    }
+    for (int i = 1; i <= 3; i++) {
+        REFUTE(_isContiguous(list));
+        cursor = CircularLinkedList_cursor_begin(list);
+        CircularLinkedList_insert_at_hint(list, &cursor, 144 + i);
+        EQUAL_INT(144 + i, CircularLinkedList_cursor_element(list, &cursor));
+    }
+    ASSERT(_isContiguous(list));
+    EQUAL_SIZE_T(17, cursor.index);
+    CircularLinkedList_free(&list);
+
+    // removals visit 7, 6 and 5 nodes, which is due for eight linked nodes in a list of five
+    list = CircularLinkedList_new();
+    CircularLinkedList_set_auto_compact(list, 1);
+    for (int i = 7; i >= 0; i--) {
+        CircularLinkedList_insert(list, i); // searches stop at the first node
+    }
+    CircularLinkedList_remove(list, 7);
+    CircularLinkedList_remove(list, 6);
+    CircularLinkedList_remove(list, 5);
+    REFUTE(_isContiguous(list));
+    cursor = CircularLinkedList_lower_bound(list, 2);
+    CircularLinkedList_remove_at_cursor(list, &cursor);
+    ASSERT(_isContiguous(list));
+    EQUAL_INT(3, CircularLinkedList_cursor_element(list, &cursor));
+    CircularLinkedList_remove_at_cursor(list, &cursor);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    ASSERT_STDOUT_EQUAL(CircularLinkedList_print(list), "0 1 4 \n");
+    CircularLinkedList_free(&list);
+}
+
+/*============================================================================*/
+/* TEST SUITE S: CircularLinkedList inline nodes                              */
+/*============================================================================*/
+TEST_CASE(CircularLinkedList_insert, "Allocates heap nodes once the inline nodes are in use") {
+    // the first CIRCULAR_LINKED_LIST_INLINE_NODES insertions allocate nothing
+    struct CircularLinkedList* list = CircularLinkedList_new();
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        for (int i = 0; i < CIRCULAR_LINKED_LIST_INLINE_NODES; i++) {
+            CircularLinkedList_insert(list, 10 * i);
+        }
+    }, 0, 0);
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        CircularLinkedList_insert(list, 5);
+    }, 1, 0, sizeof(struct Node), 0);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    ASSERT_STDOUT_EQUAL(CircularLinkedList_print(list), "0 5 10 20 \n");
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        CircularLinkedList_remove(list, 0);
+        CircularLinkedList_insert(list, 7);
+    }, 0, 0);
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        CircularLinkedList_free(&list);
+    }, 0, 2, 0, sizeof(struct CircularLinkedList) + sizeof(struct Node));
+}
+TEST_CASE(CircularLinkedList_concat, "Moves inline nodes into free inline nodes of a small destination") {
+    // nodes stored in the source list structure cannot outlive it, but their elements can
+    struct CircularLinkedList* list1 = CircularLinkedList_new();
+    struct CircularLinkedList* list2 = CircularLinkedList_new();
+    CircularLinkedList_insert(list1, 1);
+    CircularLinkedList_insert(list2, 3);
+    CircularLinkedList_insert(list2, 2);
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        CircularLinkedList_concat(list1, list2);
+    }, 0, 0);
+    EQUAL_INT(7, (int) list1->inline_used);
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        CircularLinkedList_free(&list2);
+    }, 0, 1, 0, sizeof(struct CircularLinkedList));
+    VALIDATE_CIRCULAR_LINKED_LIST(list1);
+    ASSERT_STDOUT_EQUAL(CircularLinkedList_print(list1), "1 2 3 \n");
+    CircularLinkedList_free(&list1);
+}
+TEST_CASE(CircularLinkedList_merge, "Moves inline nodes into kept nodes before allocating new ones") {
+    // a destination too large for inline nodes takes the nodes kept by the source, then its own
+    struct CircularLinkedList* list1 = CircularLinkedList_new();
+    struct CircularLinkedList* list2 = CircularLinkedList_new();
+    struct CircularLinkedList* list3 = CircularLinkedList_new();
+    for (int i = 0; i < 10; i++) {
+        CircularLinkedList_insert(list1, 10 * i);
+        CircularLinkedList_insert(list2, 10 * i);
+    }
+    CircularLinkedList_reserve(list1, 11); // one kept node
+    CircularLinkedList_clear(list2);       // ten kept nodes
+    CircularLinkedList_insert(list2, 15);
+    CircularLinkedList_insert(list2, 25);
+    CircularLinkedList_insert(list3, 1);
+    CircularLinkedList_insert(list3, 3);
+    CircularLinkedList_insert(list3, 5);
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        CircularLinkedList_merge(list1, list2);
+    }, 0, 0);
+    EQUAL_SIZE_T(8, list2->free_count);
+    EQUAL_SIZE_T(1, list1->free_count);
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        CircularLinkedList_merge(list1, list3);
+    }, 2, 0, 2 * sizeof(struct Node), 0);
+    EQUAL_SIZE_T(0, list1->free_count);
+    VALIDATE_CIRCULAR_LINKED_LIST(list1);
+    ASSERT_STDOUT_EQUAL(CircularLinkedList_print(list1), "0 1 3 5 10 15 20 25 30 40 50 60 70 80 90 \n");
+    CircularLinkedList_free(&list1);
+    CircularLinkedList_free(&list2);
+    CircularLinkedList_free(&list3);
+}
+TEST_CASE(CircularLinkedList_splice_range, "Moves inline nodes out of a single-node source") {
+    // the only node is both the last one and the node before the cursor
+    struct CircularLinkedList* list1 = CircularLinkedList_new();
+    struct CircularLinkedList* list2 = CircularLinkedList_new();
+    CircularLinkedList_insert(list1, 1);
+    CircularLinkedList_insert(list2, 4);
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_cursor_begin(list2);
+    CircularLinkedList_splice_range(list1, list2, &cursor, 1);
+    VALIDATE_CIRCULAR_LINKED_LIST(list1);
+    VALIDATE_CIRCULAR_LINKED_LIST(list2);
+    CircularLinkedList_free(&list2);
+    ASSERT_STDOUT_EQUAL(CircularLinkedList_print(list1), "1 4 \n");
+    CircularLinkedList_free(&list1);
+}
+
+TEST_CASE(CircularLinkedList_insert, "Moves inline nodes to the heap when the list outgrows them") {
+    // inline nodes are only kept by lists of at most CIRCULAR_LINKED_LIST_INLINE_LIMIT nodes
+    struct CircularLinkedList* list = CircularLinkedList_new();
+    for (int i = 0; i < CIRCULAR_LINKED_LIST_INLINE_LIMIT; i++) {
+        CircularLinkedList_insert(list, i);
+    }
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        CircularLinkedList_insert(list, -1);
+    }, CIRCULAR_LINKED_LIST_INLINE_NODES + 1, 0, (CIRCULAR_LINKED_LIST_INLINE_NODES + 1) * sizeof(struct Node), 0);
+    EQUAL_INT(0, (int) list->inline_used);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    ASSERT_STDOUT_EQUAL(CircularLinkedList_print(list), "-1 0 1 2 3 4 5 \n");
+    CircularLinkedList_free(&list);
+}
+#if !defined(CIRCULAR_LINKED_LIST_SELF_CHECK) || defined(NDEBUG)
+TEST_CASE(CircularLinkedList_concat, "Does not walk a large source") {
+    // a source built by descending insertions no longer holds the inline
+    // nodes it started with, so concat only links its ends. A link broken in
+    // the middle of the source would stop any walk
+    UT_disable_memory_tracking(); // tracking 100000 nodes would dominate the running time
+    struct CircularLinkedList* destination = CircularLinkedList_new();
+    struct CircularLinkedList* source = CircularLinkedList_new();
+    CircularLinkedList_insert(destination, -1);
+    for (int i = 99999; i >= 0; i--) {
+        CircularLinkedList_insert(source, i);
+    }
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_lower_bound(source, 50000);
+    struct Node* middle = cursor.p_previous;
+    struct Node* next = middle->p_next;
+    middle->p_next = NULL;
+    CircularLinkedList_concat(destination, source);
+    middle->p_next = next;
+    VALIDATE_CIRCULAR_LINKED_LIST(destination);
+    EQUAL_SIZE_T(100001, destination->size);
+    EQUAL_SIZE_T(0, source->size);
+    CircularLinkedList_free(&destination);
+    CircularLinkedList_free(&source);
+    UT_enable_memory_tracking();
+}
+#endif
+
+/*============================================================================*/
+/* TEST SUITE T: CircularLinkedList_clone                                     */
+/*============================================================================*/
+TEST_CASE(CircularLinkedList_clone, "Copies the elements into one block of nodes") {
+    // the copy is independent of the original and its nodes are contiguous
+    struct CircularLinkedList* list = _create_test_list((int[]){-3, 0, 0, 7, 9, 12}, 6);
+    struct CircularLinkedList* expected = _create_test_list((int[]){-3, 0, 0, 7, 9, 12}, 6);
+    struct CircularLinkedList* clone = CircularLinkedList_clone(list);
+    VALIDATE_CIRCULAR_LINKED_LIST(clone);
+    EQUAL_CIRCULAR_LINKED_LIST(expected, clone);
+    ASSERT(_isContiguous(clone));
+    CircularLinkedList_remove(list, 0);
+    CircularLinkedList_insert(clone, 20);
+    ASSERT_STDOUT_EQUAL(CircularLinkedList_print(list), "0 0 7 9 12 \n");
+    ASSERT_STDOUT_EQUAL(CircularLinkedList_print(clone), "-3 0 0 7 9 12 20 \n");
+    CircularLinkedList_free(&list);
+    CircularLinkedList_free(&clone);
+    CircularLinkedList_free(&expected);
+}
+TEST_CASE(CircularLinkedList_clone, "Takes two allocations and two deallocations") {
+    // one for the list and one for the block holding all the nodes
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3, 4, 5, 6, 7, 8}, 8);
+    struct CircularLinkedList* clone = NULL;
+    UT_mark_memory_as_baseline();
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        clone = CircularLinkedList_clone(list);
+    }, 2, 0);
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        CircularLinkedList_free(&clone);
+    }, 0, 2);
+    CircularLinkedList_free(&list);
+}
+TEST_CASE(CircularLinkedList_clone, "Frees the block with the last of its nodes, in whichever list") {
+    // nodes moved out of the copy keep its block alive after the copy is freed
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3, 4, 5, 6, 7, 8, 9, 10}, 10);
+    struct CircularLinkedList* clone = CircularLinkedList_clone(list);
+    struct CircularLinkedList* tail = CircularLinkedList_new();
+    struct CircularLinkedList_Cursor cursor = CircularLinkedList_lower_bound(clone, 6);
+    CircularLinkedList_split_at_node(tail, clone, &cursor);
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        CircularLinkedList_free(&clone);
+    }, 0, 1, 0, sizeof(struct CircularLinkedList));
+    ASSERT_STDOUT_EQUAL(CircularLinkedList_print(tail), "6 7 8 9 10 \n");
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        CircularLinkedList_free(&tail);
+    }, 0, 2);
+    CircularLinkedList_free(&list);
+}
+TEST_CASE(CircularLinkedList_clone, "Uses only inline nodes for small and empty lists") {
+    // nothing is allocated besides the list structure
+    struct CircularLinkedList* list = _create_test_list((int[]){4, 6}, 2);
+    struct CircularLinkedList* empty = _create_test_list(NULL, 0);
+    struct CircularLinkedList* clone = NULL;
+    struct CircularLinkedList* emptyClone = NULL;
+    UT_mark_memory_as_baseline();
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        clone = CircularLinkedList_clone(list);
+        emptyClone = CircularLinkedList_clone(empty);
+    }, 2, 0, 2 * sizeof(struct CircularLinkedList), 0);
+    VALIDATE_CIRCULAR_LINKED_LIST(clone);
+    VALIDATE_CIRCULAR_LINKED_LIST(emptyClone);
+    EQUAL_CIRCULAR_LINKED_LIST(list, clone);
+    EQUAL_CIRCULAR_LINKED_LIST(empty, emptyClone);
+    CircularLinkedList_insert(clone, 5);
+    ASSERT_STDOUT_EQUAL(CircularLinkedList_print(clone), "4 5 6 \n");
+    CircularLinkedList_free(&list);
+    CircularLinkedList_free(&empty);
+    CircularLinkedList_free(&clone);
+    CircularLinkedList_free(&emptyClone);
+}
+
+/*============================================================================*/
+/* TEST SUITE U: CircularLinkedList_clear and CircularLinkedList_reserve      */
+/*============================================================================*/
+TEST_CASE(CircularLinkedList_clear, "Empties the list keeping its nodes") {
+    // clearing frees nothing and refilling allocates nothing
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3, 4, 5, 6, 7}, 7);
+    UT_mark_memory_as_baseline();
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        CircularLinkedList_clear(list);
+    }, 0, 0);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    EQUAL_SIZE_T(0, list->size);
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        for (int i = 7; i > 0; i--) {
+            CircularLinkedList_insert(list, 10 * i);
+        }
+    }, 0, 0);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    ASSERT_STDOUT_EQUAL(CircularLinkedList_print(list), "10 20 30 40 50 60 70 \n");
+    CircularLinkedList_clear(list);
+    CircularLinkedList_clear(list);
+    EQUAL_SIZE_T(0, list->size);
+    CircularLinkedList_free(&list);
+}
+TEST_CASE(CircularLinkedList_clear, "Keeps only the heap nodes of a small list") {
+    // inline nodes are freed instead, so they never leave the list structure
+    struct CircularLinkedList* list = CircularLinkedList_new();
+    for (int i = 0; i < CIRCULAR_LINKED_LIST_INLINE_NODES + 2; i++) {
+        CircularLinkedList_insert(list, i);
+    }
+    CircularLinkedList_clear(list);
+    EQUAL_INT(0, (int) list->inline_used);
+    EQUAL_SIZE_T(2, list->free_count);
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        for (int i = 0; i < CIRCULAR_LINKED_LIST_INLINE_NODES + 2; i++) {
+            CircularLinkedList_insert(list, -i);
+        }
+    }, 0, 0);
+    EQUAL_SIZE_T(0, list->free_count);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    ASSERT_STDOUT_EQUAL(CircularLinkedList_print(list), "-4 -3 -2 -1 0 \n");
+    CircularLinkedList_free(&list);
+}
+TEST_CASE(CircularLinkedList_reserve, "Allocates the missing nodes at once") {
+    // free inline nodes count as available for small n; later insertions up to n allocate nothing
+    struct CircularLinkedList* list = _create_test_list((int[]){5}, 1);
+    UT_mark_memory_as_baseline();
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        CircularLinkedList_reserve(list, CIRCULAR_LINKED_LIST_INLINE_NODES);
+    }, 0, 0);
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        CircularLinkedList_reserve(list, 10);
+    }, 1, 0);
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        CircularLinkedList_reserve(list, 10);
+        for (int i = 0; i < 9; i++) {
+            CircularLinkedList_insert(list, i);
+        }
+    }, 0, 0);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    ASSERT_STDOUT_EQUAL(CircularLinkedList_print(list), "0 1 2 3 4 5 5 6 7 8 \n");
+    CircularLinkedList_free(&list);
+}
+TEST_CASE(CircularLinkedList_reserve, "Frees the kept nodes with the list") {
+    // the leak check covers kept nodes that were never used
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3, 4, 5, 6}, 6);
+    CircularLinkedList_reserve(list, 20);
+    CircularLinkedList_remove(list, 5);
+    CircularLinkedList_clear(list);
+    CircularLinkedList_insert(list, 8);
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    CircularLinkedList_free(&list);
+}
+
+#ifdef CIRCULAR_LINKED_LIST_STATS
+/*============================================================================*/
+/* TEST SUITE V: CircularLinkedList_stats                                     */
+/*============================================================================*/
+TEST_CASE(CircularLinkedList_stats, "Counts the nodes visited by insert, remove and equals") {
+    // inserting 4 into [1, 3, 5] passes 2 nodes, removing index 3 passes 3 and comparing lists of 4 visits 8
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 3, 5}, 3);
+    struct CircularLinkedList* other = _create_test_list((int[]){0, 1, 3, 5}, 4);
+    CircularLinkedList_reset_stats();
+    CircularLinkedList_insert(list, 4);
+    CircularLinkedList_insert(list, 0);
+    CircularLinkedList_remove(list, 3);
+    ASSERT(CircularLinkedList_equals(list, other));
+    const struct CircularLinkedList_Stats* stats = CircularLinkedList_stats();
+    EQUAL_SIZE_T(2, stats->insert.calls);
+    EQUAL_SIZE_T(2, stats->insert.visited);
+    EQUAL_SIZE_T(2, stats->insert.max);
+    EQUAL_SIZE_T(1, stats->insert.histogram[0]);
+    EQUAL_SIZE_T(1, stats->insert.histogram[2]);
+    EQUAL_SIZE_T(1, stats->remove.calls);
+    EQUAL_SIZE_T(3, stats->remove.visited);
+    EQUAL_SIZE_T(1, stats->equals.calls);
+    EQUAL_SIZE_T(8, stats->equals.max);
+    EQUAL_SIZE_T(1, stats->equals.histogram[4]);
+    CircularLinkedList_reset_stats();
+    EQUAL_SIZE_T(0, stats->insert.calls);
+    CircularLinkedList_free(&list);
+    CircularLinkedList_free(&other);
+}
+TEST_CASE(CircularLinkedList_write_stats_json, "Writes one object per operation") {
+    // the histogram lists every bucket, including empty ones
+    struct CircularLinkedList* list = _create_test_list(NULL, 0);
+    CircularLinkedList_reset_stats();
+    CircularLinkedList_insert(list, 1);
+    FILE* file = tmpfile();
+    REFUTE_NULL(file);
+    ASSERT(CircularLinkedList_write_stats_json(file));
+    rewind(file);
+    char json[2048];
+    size_t length = fread(json, 1, sizeof(json) - 1, file);
+    json[length] = '\0';
+    fclose(file);
+    const char* prefix = "{\"insert\": {\"calls\": 1, \"visited\": 0, \"max\": 0, \"histogram\": [1, 0, ";
+    ASSERT(strncmp(json, prefix, strlen(prefix)) == 0);
+    REFUTE_NULL(strstr(json, "\"remove\": {\"calls\": 0,"));
+    REFUTE_NULL(strstr(json, "\"equals\": {\"calls\": 0,"));
+    ASSERT(length > 2 && strcmp(json + length - 2, "}\n") == 0);
+    CircularLinkedList_free(&list);
+}
+#endif
+
+/*============================================================================*/
+/* TEST SUITE W: CircularLinkedList against a sorted array                    */
+/*============================================================================*/
+
+// Random operations are applied both to a list and to a sorted array. The
+// states are compared at checkpoints only, by size and a hash of the elements
+// in order, so long sequences run fast. On a divergence the sequence is
+// minimized, replaying it with a comparison after every operation, and printed
+enum _OperationKind { _INSERT, _REMOVE, _REMOVE_VALUE, _REMOVE_RANGE, _COMPACT, _CLEAR };
+
+struct _Operation {
+    enum _OperationKind kind;
+    int value;   // element for _INSERT and _REMOVE_VALUE
+    unsigned r1; // random numbers turned into indices when applied,
+    unsigned r2; // so that any subsequence is a valid one
+};
+
+struct _Model {
+    int* elements;
+    size_t size;
+    size_t capacity;
+};
+
+static uint64_t _random(uint64_t* state) {
+    // splitmix64
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Lists hover around 64 elements drawn from 256 values, so that there are
+// repetitions and operations stay cheap
+static struct _Operation _randomOperation(uint64_t* state, size_t size) {
+    uint64_t r = _random(state);
+    struct _Operation operation = { _INSERT, (int) ((r >> 8) & 255) - 128, (unsigned) (r >> 16), (unsigned) (r >> 40) };
+    if ((r & 127) < size) {
+        unsigned kind = (unsigned) (r >> 56) % 200;
+        operation.kind = kind < 140 ? _REMOVE : kind < 180 ? _REMOVE_VALUE : kind < 196 ? _REMOVE_RANGE : kind < 199 ? _COMPACT : _CLEAR;
+    }
+    return operation;
+}
+
+static size_t _lowerBound(const struct _Model* model, int value) {
+    size_t low = 0, high = model->size;
+    while (low < high) {
+        size_t middle = (low + high) / 2;
+        if (model->elements[middle] < value) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static void _applyToModel(struct _Model* model, const struct _Operation* operation) {
+    size_t size = model->size;
+    if (operation->kind == _INSERT) {
+        if (size == model->capacity) {
+            model->capacity = model->capacity == 0 ? 64 : 2 * model->capacity;
+            model->elements = realloc(model->elements, model->capacity * sizeof(int));
+        }
+        size_t position = _lowerBound(model, operation->value);
+        memmove(model->elements + position + 1, model->elements + position, (size - position) * sizeof(int));
+        model->elements[position] = operation->value;
+        model->size++;
+    } else if (operation->kind == _REMOVE && size > 0) {
+        size_t index = operation->r1 % size;
+        memmove(model->elements + index, model->elements + index + 1, (size - index - 1) * sizeof(int));
+        model->size--;
+    } else if (operation->kind == _REMOVE_VALUE) {
+        size_t from = _lowerBound(model, operation->value);
+        size_t to = from;
+        while (to < size && model->elements[to] == operation->value) {
+            to++;
+        }
+        memmove(model->elements + from, model->elements + to, (size - to) * sizeof(int));
+        model->size -= to - from;
+    } else if (operation->kind == _REMOVE_RANGE) {
+        size_t from = operation->r1 % (size + 1);
+        size_t to = from + operation->r2 % (size - from + 1);
+        memmove(model->elements + from, model->elements + to, (size - to) * sizeof(int));
+        model->size -= to - from;
+    } else if (operation->kind == _CLEAR) {
+        model->size = 0;
+    }
+}
+
+static void _applyToList(struct CircularLinkedList* list, const struct _Operation* operation) {
+    size_t size = list->size;
+    if (operation->kind == _INSERT) {
+        CircularLinkedList_insert(list, operation->value);
+    } else if (operation->kind == _REMOVE && size > 0) {
+        CircularLinkedList_remove(list, operation->r1 % size);
+    } else if (operation->kind == _REMOVE_VALUE) {
+        CircularLinkedList_remove_value(list, operation->value);
+    } else if (operation->kind == _REMOVE_RANGE) {
+        size_t from = operation->r1 % (size + 1);
+        CircularLinkedList_remove_range(list, from, from + operation->r2 % (size - from + 1));
+    } else if (operation->kind == _COMPACT) {
+        CircularLinkedList_compact(list);
+    } else if (operation->kind == _CLEAR) {
+        CircularLinkedList_clear(list);
+    }
+}
+
+static bool _agree(const struct CircularLinkedList* list, const struct _Model* model) {
+    if (list->size != model->size) {
+        return false;
+    }
+    uint64_t listHash = 0, modelHash = 0;
+    const struct Node* node = list->size == 0 ? NULL : list->p_last->p_next;
+    for (size_t i = 0; i < model->size; i++, node = node->p_next) {
+        listHash = listHash * 1000003 + (uint32_t) node->element;
+        modelHash = modelHash * 1000003 + (uint32_t) model->elements[i];
+    }
+    return listHash == modelHash;
+}
+
+typedef void (*_ListApplier)(struct CircularLinkedList* list, const struct _Operation* operation);
+
+// Applies operations[0..count) comparing after every one of them. Returns
+// whether the list and the model agree all along
+static bool _replay(const struct _Operation* operations, size_t count, _ListApplier applyToList) {
+    struct CircularLinkedList* list = CircularLinkedList_new();
+    struct _Model model = { NULL, 0, 0 };
+    bool agree = true;
+    for (size_t i = 0; i < count && agree; i++) {
+        applyToList(list, &operations[i]);
+        _applyToModel(&model, &operations[i]);
+        agree = _agree(list, &model);
+    }
+    CircularLinkedList_free(&list);
+    free(model.elements);
+    return agree;
+}
+
+// Removes chunks of operations, halving their length, while the remaining
+// sequence still diverges. Returns the new number of operations
+static size_t _minimize(struct _Operation* operations, size_t count, _ListApplier applyToList) {
+    struct _Operation* candidate = malloc(count * sizeof(struct _Operation));
+    for (size_t chunk = count / 2; chunk > 0; chunk /= 2) {
+        size_t start = 0;
+        while (start < count && count > 1) {
+            size_t end = start + chunk < count ? start + chunk : count;
+            memcpy(candidate, operations, start * sizeof(struct _Operation));
+            memcpy(candidate + start, operations + end, (count - end) * sizeof(struct _Operation));
+            if (!_replay(candidate, count - (end - start), applyToList)) {
+                memcpy(operations, candidate, (count - (end - start)) * sizeof(struct _Operation));
+                count -= end - start;
+            } else {
+                start = end;
+            }
+        }
+    }
+    free(candidate);
+    return count;
+}
+
+static void _printOperations(const struct _Operation* operations, size_t count) {
+    static const char* names[] = { "insert", "remove", "remove_value", "remove_range", "compact", "clear" };
+    for (size_t i = 0; i < count; i++) {
+        printf("%s %d %u %u\n", names[operations[i].kind], operations[i].value, operations[i].r1, operations[i].r2);
+    }
+}
+
+// Runs count random operations from seed, comparing every interval of them.
+// Returns 0 if the list and the model agree; otherwise prints a minimized
+// diverging sequence and returns its length
+static size_t _differential(uint64_t seed, size_t count, size_t interval, _ListApplier applyToList) {
+    struct _Operation* operations = malloc(count * sizeof(struct _Operation));
+    struct CircularLinkedList* list = CircularLinkedList_new();
+    struct _Model model = { NULL, 0, 0 };
+    size_t diverged = 0;
+    for (size_t i = 0; i < count && diverged == 0; i++) {
+        operations[i] = _randomOperation(&seed, list->size);
+        applyToList(list, &operations[i]);
+        _applyToModel(&model, &operations[i]);
+        if ((i + 1) % interval == 0 || i + 1 == count) {
+            diverged = _agree(list, &model) ? 0 : i + 1;
+        }
+    }
+    CircularLinkedList_free(&list);
+    free(model.elements);
+
+    if (diverged != 0) {
+        diverged = _minimize(operations, diverged, applyToList);
+        printf("List and sorted array diverge; minimized sequence of length %zu (kind value r1 r2):\n", diverged);
+        _printOperations(operations, diverged);
+    }
+    free(operations);
+    return diverged;
+}
+
+// Loses insertions of 13, to check that divergences are found and minimized
+static void _applyToListDroppingThirteen(struct CircularLinkedList* list, const struct _Operation* operation) {
+    if (operation->kind != _INSERT || operation->value != 13) {
+        _applyToList(list, operation);
+    }
+}
+
+TEST_CASE(CircularLinkedList, "Agrees with a sorted array over a million random operations") {
+    // memory tracking is suspended: it would dominate the running time
+    UT_disable_memory_tracking();
+    size_t diverged = 0;
+    for (uint64_t seed = 1; seed <= 4; seed++) {
+        diverged += _differential(seed, 250000, 1000, _applyToList);
+    }
+    UT_enable_memory_tracking();
+    EQUAL_SIZE_T(0, diverged);
+}
+TEST_CASE(CircularLinkedList, "Differential check reduces a divergence to a minimal sequence") {
+    // a single insertion of 13 is enough to expose the faulty list
+    UT_disable_memory_tracking();
+    size_t diverged = 0;
+    ASSERT_STDOUT_EQUAL(diverged = _differential(1, 100000, 1000, _applyToListDroppingThirteen),
+                        "List and sorted array diverge; minimized sequence of length 1 (kind value r1 r2):\n"
+                        "insert 13 1251630903 14216778\n");
+    UT_enable_memory_tracking();
+    EQUAL_SIZE_T(1, diverged);
+}
+
+/*============================================================================*/
+/* TEST SUITE X: CircularLinkedList on large fixture lists                    */
+/*============================================================================*/
+// Millions of elements take about a second in unoptimized or sanitized
+// builds, too close to the default timeout of the forked test processes
+#define LARGE_FIXTURE_TIMEOUT_MS 30000
+
+TEST_CASE_WITH_TIMEOUT(CircularLinkedList, "Fixture lists take one block, or none that is tracked", LARGE_FIXTURE_TIMEOUT_MS) {
+    // two million elements cost no tracked allocation, and ten cost just one
+    struct CircularLinkedList* large = NULL;
+    struct CircularLinkedList* small = NULL;
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        large = _create_fixture_list(_progression, &(struct _Progression){-1000000, 1}, 2000000, false);
+    }, 0, 0);
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        small = _create_fixture_list(_progression, &(struct _Progression){0, 3}, 10, true);
+    }, 1, 0);
+    VALIDATE_CIRCULAR_LINKED_LIST(large);
+    VALIDATE_CIRCULAR_LINKED_LIST(small);
+    EQUAL_SIZE_T(2000000, large->size);
+    EQUAL_INT(-1000000, CircularLinkedList_min(large));
+    EQUAL_INT(999999, CircularLinkedList_max(large));
+    ASSERT_STDOUT_EQUAL(CircularLinkedList_print(small), "0 3 6 9 12 15 18 21 24 27 \n");
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        _free_fixture_list(&large, false);
+        _free_fixture_list(&small, true);
+    }, 0, 1);
+    ASSERT(large == NULL && small == NULL);
+}
+TEST_CASE_WITH_TIMEOUT(CircularLinkedList, "Removes half of a million-element list", LARGE_FIXTURE_TIMEOUT_MS) {
+    // the back half of the clone is what is left
+    struct CircularLinkedList* list = _create_fixture_list(_progression, &(struct _Progression){0, 2}, 1000000, false);
+    struct CircularLinkedList* expected = _create_fixture_list(_progression, &(struct _Progression){1000000, 2}, 500000, false);
+    struct CircularLinkedList* clone = CircularLinkedList_clone(list);
+    CircularLinkedList_remove_range(clone, 0, 500000);
+    VALIDATE_CIRCULAR_LINKED_LIST(clone);
+    EQUAL_CIRCULAR_LINKED_LIST(expected, clone);
+    CircularLinkedList_free(&clone);
+    _free_fixture_list(&list, false);
+    _free_fixture_list(&expected, false);
+}
+TEST_CASE_WITH_TIMEOUT(CircularLinkedList, "Merges two million-element lists", LARGE_FIXTURE_TIMEOUT_MS) {
+    // even and odd numbers interleave into all of them
+    struct CircularLinkedList* evens = _create_fixture_list(_progression, &(struct _Progression){0, 2}, 1000000, false);
+    struct CircularLinkedList* odds = _create_fixture_list(_progression, &(struct _Progression){1, 2}, 1000000, false);
+    struct CircularLinkedList* expected = _create_fixture_list(_progression, &(struct _Progression){0, 1}, 2000000, false);
+    struct CircularLinkedList* destination = CircularLinkedList_clone(evens);
+    struct CircularLinkedList* source = CircularLinkedList_clone(odds);
+    CircularLinkedList_merge(destination, source);
+    VALIDATE_CIRCULAR_LINKED_LIST(destination);
+    EQUAL_CIRCULAR_LINKED_LIST(expected, destination);
+    EQUAL_SIZE_T(0, source->size);
+    CircularLinkedList_free(&destination);
+    CircularLinkedList_free(&source);
+    _free_fixture_list(&evens, false);
+    _free_fixture_list(&odds, false);
+    _free_fixture_list(&expected, false);
+}
+
+/*============================================================================*/
+/* TEST SUITE Y: CircularLinkedList validation and self-check                 */
+/*============================================================================*/
+TEST_CASE(CircularLinkedList_validation, "Rejects a cycle that does not go through the first node") {
+    // the nodes in the cycle are equal, so that they stay sorted however many times they are walked
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 2, 2, 5}, 5);
+    struct Node* second = list->p_last->p_next->p_next;
+    struct Node* fourth = second->p_next->p_next;
+    char buffer[256];
+    fourth->p_next = second;
+    REFUTE(_validateList(list, buffer, sizeof(buffer)));
+    ASSERT(strstr(buffer, "not circular") != NULL);
+    fourth->p_next = list->p_last;
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    CircularLinkedList_free(&list);
+}
+TEST_CASE(CircularLinkedList_validation, "Rejects unsorted elements") {
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3}, 3);
+    struct Node* second = list->p_last->p_next->p_next;
+    char buffer[256];
+    second->element = 5;
+    REFUTE(_validateList(list, buffer, sizeof(buffer)));
+    ASSERT(strstr(buffer, "not sorted") != NULL);
+    second->element = 2;
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    CircularLinkedList_free(&list);
+}
+TEST_CASE(CircularLinkedList_validation, "Rejects a p_last that is not the last node") {
+    // a node outside the list that links to its first node
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3}, 3);
+    struct Node* last = list->p_last;
+    struct Node stray = {3, 0, last->p_next};
+    char buffer[256];
+    list->p_last = &stray;
+    REFUTE(_validateList(list, buffer, sizeof(buffer)));
+    ASSERT(strstr(buffer, "p_last inconsistency") != NULL);
+    list->p_last = last;
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    CircularLinkedList_free(&list);
+}
+TEST_CASE(CircularLinkedList_validation, "Rejects a size that does not match the nodes") {
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3}, 3);
+    char buffer[256];
+    list->size = 4;
+    REFUTE(_validateList(list, buffer, sizeof(buffer)));
+    ASSERT(strstr(buffer, "Node count mismatch") != NULL);
+    list->size = 2;
+    REFUTE(_validateList(list, buffer, sizeof(buffer)));
+    ASSERT(strstr(buffer, "Node count mismatch") != NULL);
+    list->size = 3;
+    VALIDATE_CIRCULAR_LINKED_LIST(list);
+    CircularLinkedList_free(&list);
+}
+#if defined(CIRCULAR_LINKED_LIST_SELF_CHECK) && !defined(NDEBUG)
+TEST_ASSERTION_FAILURE_WITH_SIMILAR_MESSAGE(CircularLinkedList_insert, "Self-check catches unsorted elements", "Elements are not sorted") {
+    // the tail fast path appends without looking at the corrupted node
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3}, 3);
+    list->p_last->p_next->p_next->element = 5;
+    CircularLinkedList_insert(list, 10);
+}
+TEST_ASSERTION_FAILURE_WITH_SIMILAR_MESSAGE(CircularLinkedList_insert, "Self-check catches a cycle that does not go through the first node", "Cycle that does not go through the first node") {
+    // the new first node leads into a cycle of equal elements, from the fourth node back to the second
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 2, 2, 5}, 5);
+    struct Node* second = list->p_last->p_next->p_next;
+    second->p_next->p_next->p_next = second;
+    CircularLinkedList_insert(list, 0);
+}
+TEST_ASSERTION_FAILURE_WITH_SIMILAR_MESSAGE(CircularLinkedList_remove, "Self-check catches a wrong size", "Size does not match the number of nodes") {
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3, 4}, 4);
+    list->size = 5;
+    CircularLinkedList_remove(list, 0);
+}
+TEST_ASSERTION_FAILURE_WITH_SIMILAR_MESSAGE(CircularLinkedList_remove, "Self-check catches a wrong p_last", "p_last is not the last node") {
+    // removal walks from p_last, which is a node outside the list that links to its first node
+    struct CircularLinkedList* list = _create_test_list((int[]){1, 2, 3}, 3);
+    struct Node stray = {3, 0, list->p_last->p_next};
+    list->p_last = &stray;
+    CircularLinkedList_remove(list, 2);
+}
+#endif
+
+/*============================================================================*/
+/* UnrolledCircularLinkedList                                                 */
+/*============================================================================*/
+
+// Checks node occupancy, padding slots, ordering, circularity and size
+static bool _isValidUnrolled(const struct UnrolledCircularLinkedList* list) {
+    if (list->size == 0) {
+        return list->p_last == NULL;
+    }
+    const struct UnrolledNode* first = list->p_last->p_next;
+    const struct UnrolledNode* node = first;
+    size_t counted = 0;
+    int previous = INT_MIN;
+    do {
+        if (node->count <= 0 || node->count > UNROLLED_NODE_CAPACITY) {
+            return false;
+        }
+        for (int i = 0; i < UNROLLED_NODE_CAPACITY; i++) {
+            if (i < node->count) {
+                if (node->elements[i] < previous) {
+                    return false;
+                }
+                previous = node->elements[i];
+            } else if (node->elements[i] != INT_MAX) {
+                return false;
+            }
+        }
+        counted += node->count;
+        if (counted > list->size) {
+            return false;
+        }
+        node = node->p_next;
+    } while (node != first);
+    return counted == list->size;
+}
+
+static size_t _nodeCount(const struct UnrolledCircularLinkedList* list) {
+    size_t nodes = 0;
+    if (list->p_last != NULL) {
+        const struct UnrolledNode* node = list->p_last;
+        do {
+            nodes++;
+            node = node->p_next;
+        } while (node != list->p_last);
+    }
+    return nodes;
+}
+
+/*============================================================================*/
+/* TEST SUITE: UnrolledCircularLinkedList_insert                              */
+/*============================================================================*/
+TEST_ASSERTION_FAILURE_WITH_SIMILAR_MESSAGE(UnrolledCircularLinkedList_insert, "Assertion should fail on NULL p_list parameter with \"List is NULL\" message", "List is NULL") {
+    // attempt to insert into a NULL list should trigger an assertion failure with the correct message
+    UnrolledCircularLinkedList_insert(NULL, 10);
+}
+TEST_CASE(UnrolledCircularLinkedList_insert, "Splits a full node in two") {
+    // inserting one element more than a node can hold must allocate a second node
+    struct UnrolledCircularLinkedList* list = UnrolledCircularLinkedList_new();
+    for (int i = 0; i < UNROLLED_NODE_CAPACITY; i++) {
+        UnrolledCircularLinkedList_insert(list, 2 * i);
+    }
+    EQUAL_SIZE_T(1, _nodeCount(list));
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        UnrolledCircularLinkedList_insert(list, 7);
+    }, 1, 0, sizeof(struct UnrolledNode), 0);
+    EQUAL_SIZE_T(2, _nodeCount(list));
+    ASSERT(_isValidUnrolled(list));
+    UnrolledCircularLinkedList_free(&list);
+}
+#if !defined(_MSC_VER)
+TEST_CASE(UnrolledCircularLinkedList_insert, "Allocates each node on its own cache line") {
+    // nodes are as large as a cache line and start at a line boundary
+    struct UnrolledCircularLinkedList* list = UnrolledCircularLinkedList_new();
+    for (int i = 0; i < 5 * UNROLLED_NODE_CAPACITY; i++) {
+        UnrolledCircularLinkedList_insert(list, i);
+    }
+    const struct UnrolledNode* node = list->p_last;
+    do {
+        EQUAL_SIZE_T(0, (size_t) ((uintptr_t) node % UNROLLED_NODE_ALIGNMENT));
+        node = node->p_next;
+    } while (node != list->p_last);
+    UnrolledCircularLinkedList_free(&list);
+}
+#endif
+TEST_CASE(UnrolledCircularLinkedList_insert, "Keeps elements sorted for a shuffled sequence with duplicates") {
+    // insert a permutation with duplicates and check the final order
+    struct UnrolledCircularLinkedList* list = UnrolledCircularLinkedList_new();
+    for (int i = 0; i < 200; i++) {
+        UnrolledCircularLinkedList_insert(list, (i * 37) % 101);
+    }
+    EQUAL_SIZE_T(200, list->size);
+    ASSERT(_isValidUnrolled(list));
+    UnrolledCircularLinkedList_free(&list);
+}
+
+/*============================================================================*/
+/* TEST SUITE: UnrolledCircularLinkedList_remove                              */
+/*============================================================================*/
+TEST_ASSERTION_FAILURE_WITH_SIMILAR_MESSAGE(UnrolledCircularLinkedList_remove, "Assertion should fail with on out of bounds index with \"Index out of bounds\" message", "Index out of bounds") {
+    // attempt to remove an element at an out-of-bounds index should trigger an assertion failure with the correct message
+    struct UnrolledCircularLinkedList* list = UnrolledCircularLinkedList_new();
+    UnrolledCircularLinkedList_insert(list, 1);
+    UnrolledCircularLinkedList_remove(list, 1);
+}
+TEST_CASE(UnrolledCircularLinkedList_remove, "Merges underfull nodes and frees them all when emptied") {
+    // remove from the front until the list is empty; nodes must be merged and released along the way
+    struct UnrolledCircularLinkedList* list = UnrolledCircularLinkedList_new();
+    for (int i = 100; i > 0; i--) {
+        UnrolledCircularLinkedList_insert(list, i);
+    }
+    size_t nodes = _nodeCount(list);
+    for (int i = 0; i < 60; i++) {
+        UnrolledCircularLinkedList_remove(list, 0);
+        ASSERT(_isValidUnrolled(list));
+    }
+    ASSERT(_nodeCount(list) < nodes);
+    while (list->size > 0) {
+        UnrolledCircularLinkedList_remove(list, list->size - 1);
+    }
+    ASSERT(_isValidUnrolled(list));
+    ASSERT_NULL(list->p_last);
+    UnrolledCircularLinkedList_free(&list);
+}
+
+/*============================================================================*/
+/* TEST SUITE: UnrolledCircularLinkedList_equals                              */
+/*============================================================================*/
+TEST_CASE(UnrolledCircularLinkedList_equals, "Returns true for equal lists with different node layouts") {
+    // ascending and descending insertion split the nodes differently
+    struct UnrolledCircularLinkedList* list1 = UnrolledCircularLinkedList_new();
+    struct UnrolledCircularLinkedList* list2 = UnrolledCircularLinkedList_new();
+    for (int i = 0; i < 50; i++) {
+        UnrolledCircularLinkedList_insert(list1, i);
+        UnrolledCircularLinkedList_insert(list2, 49 - i);
+    }
+    ASSERT(UnrolledCircularLinkedList_equals(list1, list2));
+    UnrolledCircularLinkedList_remove(list2, 25);
+    UnrolledCircularLinkedList_insert(list2, 1000);
+    REFUTE(UnrolledCircularLinkedList_equals(list1, list2));
+    UnrolledCircularLinkedList_free(&list1);
+    UnrolledCircularLinkedList_free(&list2);
+}
+
+/*============================================================================*/
+/* TEST SUITE: UnrolledCircularLinkedList_print                               */
+/*============================================================================*/
+TEST_CASE(UnrolledCircularLinkedList_print, "Prints elements across several nodes") {
+    // output format must match CircularLinkedList_print
+    struct UnrolledCircularLinkedList* list = UnrolledCircularLinkedList_new();
+    ASSERT_STDOUT_EQUAL(UnrolledCircularLinkedList_print(list), "\n");
+    for (int i = 15; i > 0; i--) {
+        UnrolledCircularLinkedList_insert(list, i);
+    }
+    ASSERT_STDOUT_EQUAL(UnrolledCircularLinkedList_print(list), "1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 \n");
+    UnrolledCircularLinkedList_free(&list);
+}
+
+/*============================================================================*/
+/* SortedRingBuffer                                                           */
+/*============================================================================*/
+static bool _isSortedRingBuffer(const struct SortedRingBuffer* buffer) {
+    for (size_t i = 1; i < buffer->size; i++) {
+        if (SortedRingBuffer_get(buffer, i - 1) > SortedRingBuffer_get(buffer, i)) {
+            return false;
+        }
+    }
+    return buffer->size <= buffer->capacity;
+}
+
+TEST_CASE(SortedRingBuffer_insert, "Keeps elements sorted while wrapping around and growing") {
+    // alternate inserts at both ends and in the middle so that the storage wraps and grows
+    struct SortedRingBuffer* buffer = SortedRingBuffer_new();
+    for (int i = 0; i < 100; i++) {
+        SortedRingBuffer_insert(buffer, i % 2 == 0 ? -i : i);
+        SortedRingBuffer_insert(buffer, (i * 37) % 11);
+        ASSERT(_isSortedRingBuffer(buffer));
+    }
+    EQUAL_SIZE_T(200, buffer->size);
+    EQUAL_INT(-98, SortedRingBuffer_get(buffer, 0));
+    EQUAL_INT(99, SortedRingBuffer_get(buffer, 199));
+    SortedRingBuffer_free(&buffer);
+}
+TEST_CASE(SortedRingBuffer_insert, "Does not allocate while there is spare capacity") {
+    // only the first insertion allocates storage
+    struct SortedRingBuffer* buffer = SortedRingBuffer_new();
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        SortedRingBuffer_insert(buffer, 5);
+    }, 1, 0);
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        SortedRingBuffer_insert(buffer, 3);
+        SortedRingBuffer_insert(buffer, 7);
+    }, 0, 0);
+    SortedRingBuffer_free(&buffer);
+}
+TEST_ASSERTION_FAILURE_WITH_SIMILAR_MESSAGE(SortedRingBuffer_remove, "Assertion should fail with on out of bounds index with \"Index out of bounds\" message", "Index out of bounds") {
+    // attempt to remove an element at an out-of-bounds index should trigger an assertion failure with the correct message
+    struct SortedRingBuffer* buffer = SortedRingBuffer_new();
+    SortedRingBuffer_remove(buffer, 0);
+}
+TEST_CASE(SortedRingBuffer_remove, "Removes elements from both halves") {
+    // removals close the gap from the shorter side; order must be preserved
+    struct SortedRingBuffer* buffer = SortedRingBuffer_new();
+    for (int i = 9; i >= 0; i--) {
+        SortedRingBuffer_insert(buffer, i);
+    }
+    SortedRingBuffer_remove(buffer, 1);
+    SortedRingBuffer_remove(buffer, 7);
+    SortedRingBuffer_remove(buffer, 0);
+    ASSERT_STDOUT_EQUAL(SortedRingBuffer_print(buffer), "2 3 4 5 6 7 9 \n");
+    while (buffer->size > 0) {
+        SortedRingBuffer_remove(buffer, buffer->size / 2);
+        ASSERT(_isSortedRingBuffer(buffer));
+    }
+    SortedRingBuffer_free(&buffer);
+}
+TEST_CASE(SortedRingBuffer_equals, "Compares buffers with different head positions") {
+    // equal contents stored at different offsets must compare equal
+    struct SortedRingBuffer* buffer1 = SortedRingBuffer_new();
+    struct SortedRingBuffer* buffer2 = SortedRingBuffer_new();
+    for (int i = 0; i < 6; i++) {
+        SortedRingBuffer_insert(buffer1, i);
+        SortedRingBuffer_insert(buffer2, 5 - i);
+    }
+    ASSERT(SortedRingBuffer_equals(buffer1, buffer2));
+    SortedRingBuffer_remove(buffer2, 0);
+    REFUTE(SortedRingBuffer_equals(buffer1, buffer2));
+    SortedRingBuffer_free(&buffer1);
+    SortedRingBuffer_free(&buffer2);
+}
+
+/*============================================================================*/
+/* RunLengthCircularLinkedList                                                */
+/*============================================================================*/
+
+// Checks that elements strictly increase, counts are positive and add up to size
+static bool _isValidRunLength(const struct RunLengthCircularLinkedList* list) {
+    if (list->runs == 0) {
+        return list->p_last == NULL && list->size == 0;
+    }
+    const struct RunNode* first = list->p_last->p_next;
+    const struct RunNode* node = first;
+    size_t size = 0;
+    for (size_t i = 0; i < list->runs; i++) {
+        if (node->count == 0 || (i + 1 < list->runs && node->element >= node->p_next->element)) {
+            return false;
+        }
+        size += node->count;
+        node = node->p_next;
+    }
+    return node == first && size == list->size;
+}
+
+TEST_CASE(RunLengthCircularLinkedList_insert, "Stores repeated elements in a single node") {
+    // only the first occurrence of an element allocates a node
+    struct RunLengthCircularLinkedList* list = RunLengthCircularLinkedList_new();
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        RunLengthCircularLinkedList_insert(list, 5);
+    }, 1, 0, sizeof(struct RunNode), 0);
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        for (int i = 0; i < 1000; i++) {
+            RunLengthCircularLinkedList_insert(list, 5);
+        }
+    }, 0, 0);
+    RunLengthCircularLinkedList_insert(list, 9);
+    RunLengthCircularLinkedList_insert(list, -2);
+    RunLengthCircularLinkedList_insert(list, 9);
+    ASSERT(_isValidRunLength(list));
+    EQUAL_SIZE_T(1004, list->size);
+    EQUAL_SIZE_T(3, list->runs);
+    EQUAL_SIZE_T(1001, RunLengthCircularLinkedList_count(list, 5));
+    EQUAL_SIZE_T(2, RunLengthCircularLinkedList_count(list, 9));
+    EQUAL_SIZE_T(0, RunLengthCircularLinkedList_count(list, 7));
+    RunLengthCircularLinkedList_free(&list);
+}
+TEST_CASE(RunLengthCircularLinkedList_remove, "Indexes elements through the counts of the runs") {
+    // removing the last occurrence of an element frees its node
+    struct RunLengthCircularLinkedList* list = RunLengthCircularLinkedList_new();
+    int values[] = {3, 1, 3, 2, 3, 1};
+    for (int i = 0; i < 6; i++) {
+        RunLengthCircularLinkedList_insert(list, values[i]);
+    }
+    ASSERT_STDOUT_EQUAL(RunLengthCircularLinkedList_print(list), "1 1 2 3 3 3 \n");
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        RunLengthCircularLinkedList_remove(list, 4);
+    }, 0, 0);
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        RunLengthCircularLinkedList_remove(list, 2);
+    }, 0, 1, 0, sizeof(struct RunNode));
+    ASSERT_STDOUT_EQUAL(RunLengthCircularLinkedList_print(list), "1 1 3 3 \n");
+    ASSERT(_isValidRunLength(list));
+    while (list->size > 0) {
+        RunLengthCircularLinkedList_remove(list, list->size - 1);
+        ASSERT(_isValidRunLength(list));
+    }
+    ASSERT_NULL(list->p_last);
+    RunLengthCircularLinkedList_free(&list);
+}
+TEST_ASSERTION_FAILURE_WITH_SIMILAR_MESSAGE(RunLengthCircularLinkedList_remove, "Assertion should fail on out of bounds index with \"Index out of bounds\" message", "Index out of bounds") {
+    // an index equal to size is out of bounds even if the last run is long
+    struct RunLengthCircularLinkedList* list = RunLengthCircularLinkedList_new();
+    RunLengthCircularLinkedList_insert(list, 1);
+    RunLengthCircularLinkedList_insert(list, 1);
+    RunLengthCircularLinkedList_remove(list, 2);
+}
+TEST_CASE(RunLengthCircularLinkedList_equals, "Compares multisets") {
+    // same distinct elements with different counts are not equal
+    struct RunLengthCircularLinkedList* list1 = RunLengthCircularLinkedList_new();
+    struct RunLengthCircularLinkedList* list2 = RunLengthCircularLinkedList_new();
+    RunLengthCircularLinkedList_insert(list1, 1);
+    RunLengthCircularLinkedList_insert(list1, 1);
+    RunLengthCircularLinkedList_insert(list1, 2);
+    RunLengthCircularLinkedList_insert(list2, 2);
+    RunLengthCircularLinkedList_insert(list2, 1);
+    RunLengthCircularLinkedList_insert(list2, 2);
+    REFUTE(RunLengthCircularLinkedList_equals(list1, list2));
+    RunLengthCircularLinkedList_remove(list2, 2);
+    RunLengthCircularLinkedList_insert(list2, 1);
+    ASSERT(RunLengthCircularLinkedList_equals(list1, list2));
+    RunLengthCircularLinkedList_free(&list1);
+    RunLengthCircularLinkedList_free(&list2);
+}
+
+/*============================================================================*/
+/* ArenaCircularLinkedList                                                    */
+/*============================================================================*/
+
+// Checks ordering and circularity, and that live and free slots add up to used
+static bool _isValidArena(const struct ArenaCircularLinkedList* list) {
+    size_t freeSlots = 0;
+    for (uint32_t slot = list->first_free; slot != ARENA_NIL; slot = list->p_nodes[slot].next) {
+        if (slot >= list->used || ++freeSlots > list->used) {
+            return false;
+        }
+    }
+    if (list->size + freeSlots != list->used || list->used > list->capacity) {
+        return false;
+    }
+    if (list->size == 0) {
+        return list->last == ARENA_NIL;
+    }
+    uint32_t first = list->p_nodes[list->last].next;
+    uint32_t node = first;
+    for (size_t i = 0; i < list->size; i++) {
+        uint32_t next = list->p_nodes[node].next;
+        if (i + 1 < list->size && list->p_nodes[node].element > list->p_nodes[next].element) {
+            return false;
+        }
+        if (i + 1 == list->size && (node != list->last || next != first)) {
+            return false;
+        }
+        node = next;
+    }
+    return true;
+}
+
+TEST_CASE(ArenaCircularLinkedList_insert, "Uses 8-byte nodes and keeps elements sorted") {
+    // shuffled inserts with duplicates across several growths of the storage
+    EQUAL_SIZE_T(8, sizeof(struct ArenaNode));
+    struct ArenaCircularLinkedList* list = ArenaCircularLinkedList_new();
+    for (int i = 0; i < 100; i++) {
+        ArenaCircularLinkedList_insert(list, (i * 37) % 51);
+        ASSERT(_isValidArena(list));
+    }
+    EQUAL_SIZE_T(100, list->size);
+    EQUAL_INT(0, list->p_nodes[list->p_nodes[list->last].next].element);
+    EQUAL_INT(50, list->p_nodes[list->last].element);
+    ArenaCircularLinkedList_free(&list);
+    ASSERT_NULL(list);
+}
+TEST_CASE(ArenaCircularLinkedList_insert, "Allocates storage only when it is full") {
+    // the first insertion allocates the storage; it is then reallocated when it doubles
+    struct ArenaCircularLinkedList* list = ArenaCircularLinkedList_new();
+    ASSERT_AND_MARK_MEMORY_CHANGES_BYTES({
+        ArenaCircularLinkedList_insert(list, 1);
+    }, 1, 0, 16 * sizeof(struct ArenaNode), 0);
+    ASSERT_AND_MARK_MEMORY_CHANGES({
+        for (int i = 0; i < 15; i++) {
+            ArenaCircularLinkedList_insert(list, i);
+        }
+    }, 0, 0);
+    ArenaCircularLinkedList_insert(list, 99);
+    EQUAL_INT(32, (int) list->capacity);
+    ASSERT(_isValidArena(list));
+    ArenaCircularLinkedList_free(&list);
+}
+TEST_CASE(ArenaCircularLinkedList_remove, "Reuses the slots of removed nodes") {
+    // removals push slots onto the free list, insertions pop them
+    struct ArenaCircularLinkedList* list = ArenaCircularLinkedList_new();
+    for (int i = 0; i < 10; i++) {
+        ArenaCircularLinkedList_insert(list, i);
+    }
+    ArenaCircularLinkedList_remove(list, 9);
+    ArenaCircularLinkedList_remove(list, 0);
+    ArenaCircularLinkedList_remove(list, 4);
+    ASSERT(_isValidArena(list));
+    ASSERT_STDOUT_EQUAL(ArenaCircularLinkedList_print(list), "1 2 3 4 6 7 8 \n");
+    ArenaCircularLinkedList_insert(list, 5);
+    ArenaCircularLinkedList_insert(list, 0);
+    ArenaCircularLinkedList_insert(list, 20);
+    EQUAL_INT(10, (int) list->used);
+    ASSERT(_isValidArena(list));
+    while (list->size > 0) {
+        ArenaCircularLinkedList_remove(list, list->size / 2);
+        ASSERT(_isValidArena(list));
+    }
+    ArenaCircularLinkedList_free(&list);
+}
+TEST_CASE(ArenaCircularLinkedList_equals, "Compares lists whose nodes are in different slots") {
+    // slot order does not matter, only element order
+    struct ArenaCircularLinkedList* list1 = ArenaCircularLinkedList_new();
+    struct ArenaCircularLinkedList* list2 = ArenaCircularLinkedList_new();
+    for (int i = 0; i < 6; i++) {
+        ArenaCircularLinkedList_insert(list1, i);
+        ArenaCircularLinkedList_insert(list2, 5 - i);
+    }
+    ASSERT(ArenaCircularLinkedList_equals(list1, list2));
+    ArenaCircularLinkedList_remove(list2, 0);
+    REFUTE(ArenaCircularLinkedList_equals(list1, list2));
+    ArenaCircularLinkedList_free(&list1);
+    ArenaCircularLinkedList_free(&list2);
+}
+
 /*============================================================================*/
 /* MAIN FUNCTION                                                              */
 /*============================================================================*/